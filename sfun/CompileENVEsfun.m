@@ -108,6 +108,7 @@ def.HostLibFiles = {lib_name};
 
 def.StartFcnSpec = [ ...
   'void enve_sfun_init(', ...
+  'void        **work1, ', ... % Block instance work pointer
   'EnveRealPar p1[1], ',  ... % Ribs number (-)
   'EnveRealPar p2[1], ', ... % Shell radius on x-axis (m)
   'EnveRealPar p3[1], ', ... % Shell curve degree for x-axis (-)
@@ -120,6 +121,7 @@ def.StartFcnSpec = [ ...
 
 def.OutputFcnSpec = [ ...
   'void enve_sfun_out(', ...
+  'void        **work1, ', ... % Block instance work pointer
   'EnveInputBus  u1[1], ', ... % Input bus containing the shell hub affine transformation matrix
   'EnveOutputBus y1[1], ', ... % Output bus containing the contact data
   'EnveRealPar   p9[1], ', ... % method 0: ENVE use geometric enveloping, 1: ENVE use sampling enveloping
@@ -127,7 +129,7 @@ def.OutputFcnSpec = [ ...
   ];
 
 def.TerminateFcnSpec = [...
-  'void enve_sfun_end()' ...
+  'void enve_sfun_end(void **work1)' ... % Block instance work pointer
   ];
 
 %% Create MEX
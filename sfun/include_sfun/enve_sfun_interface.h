@@ -48,6 +48,7 @@ extern "C"
   // S-function entry point for initialization
   void
   enve_sfun_init(
+          void       **WorkPtr,        // Block instance work pointer (one per S-function block)
     const EnveRealPar *SizePar,        // Ribs number (-)
     const EnveRealPar *Rx,             // Shell radius on x-axis (m)
     const EnveRealPar *Mx,             // Shell curve degree for x-axis (-)
@@ -61,6 +62,7 @@ extern "C"
   // S-function entry point for step update
   void
   enve_sfun_out(
+          void         **WorkPtr,      // Block instance work pointer (one per S-function block)
     const EnveInputBus  *InputBus,     // Input bus containing the shell hub affine transformation matrix
           EnveOutputBus *OutputBus,    // Output bus containing the contact data
     const EnveRealPar   *MethodPar,    // method 0: ENVE use geometric enveloping, 1: ENVE use sampling enveloping
@@ -69,7 +71,9 @@ extern "C"
 
   // S-function entry point for deletion of allocated memory
   void
-  enve_sfun_end(void);
+  enve_sfun_end(
+    void **WorkPtr // Block instance work pointer (one per S-function block)
+  );
 
 #ifdef __cplusplus
 }
@@ -38,17 +38,81 @@
 #include "enve_sfun_interface.h"
 #include "enve.hh"
 
+#include <map>
+#include <mutex>
+
+namespace
+{
+
+  // S-function block instance data
+  struct EnveInstance
+  {
+    std::shared_ptr<enve::ground::mesh::future const> mesh; // Shared mesh ground (loaded asynchronously)
+    std::unique_ptr<enve::ground::flat>               flat;  // Back-up flat ground
+    std::unique_ptr<enve::shell>                      shell; // Tire shell
+  };
+
+  // Process-wide mesh ground cache, the meshes are shared by all the blocks
+  // loading the same file with the same pose and released with the last one
+  std::mutex                                                              CacheMutex;
+  std::map<std::string, std::weak_ptr<enve::ground::mesh::future const> > CacheMeshes;
+
+  // Start loading a mesh ground or get it from the cache
+  std::shared_ptr<enve::ground::mesh::future const>
+  enve_sfun_mesh(
+    std::string  const & path,
+    acme::affine const & pose
+  )
+  {
+    #define CMD "enve_sfun_mesh(...): "
+
+    // Build the cache key from path and pose
+    std::ostringstream key;
+    key.precision(17);
+    key << path;
+    for (int i = 0; i < 16; ++i)
+      {key << ' ' << *(pose.data() + i);}
+
+    std::lock_guard<std::mutex> lock(CacheMutex);
+    std::weak_ptr<enve::ground::mesh::future const> & entry = CacheMeshes[key.str()];
+    std::shared_ptr<enve::ground::mesh::future const> mesh  = entry.lock();
+    if (mesh)
+      {return mesh;}
+
+    // Drop the expired entries
+    for (auto it = CacheMeshes.begin(); it != CacheMeshes.end();)
+    {
+      if (it->second.expired() && it->first != key.str())
+        {it = CacheMeshes.erase(it);}
+      else
+        {++it;}
+    }
+
+    // Start building mesh
+    typedef enve::ground::mesh::future future;
+    std::string extension = path.size() < 4 ? "" : path.substr(path.size() - 4, 4);
+    if (extension == ".rdf")
+      {mesh = std::make_shared<future const>(enve::ground::mesh::loadAsync(path, pose));}
+    else if (extension == ".obj")
+      {mesh = std::make_shared<future const>(enve::ground::mesh::loadAsync(path, 1.0, pose));}
+    else
+      {ENVE_ERROR(CMD "not a *.rdf or *.obj file.");}
+    entry = mesh;
+    return mesh;
+
+    #undef CMD
+  }
+
+} // namespace
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
-  void *MeshPtr;
-  void *FlatPtr;
-  void *ShellPtr;
-
   void
   enve_sfun_init(
+          void       **WorkPtr,
     const EnveRealPar *SizePar,
     const EnveRealPar *Rx,
     const EnveRealPar *Mx,
@@ -71,41 +135,40 @@ extern "C"
     // TODO: add affine transformation
     affine pose(IDENTITY_AFFINE);
 
-    // Build mesh
-    std::string extension = mesh_path.substr(mesh_path.size() - 4, 4);
-    enve::ground::mesh *mesh = nullptr;
-    if (extension == ".rdf")
-      {mesh = new enve::ground::mesh(mesh_path, pose);}
-    else if (extension == ".obj")
-      {mesh = new enve::ground::mesh(mesh_path, 1.0, pose);}
-    else
-      {ENVE_ERROR(CMD "not a *.rdf or *.obj file.");}
+    // Build the block instance
+    std::unique_ptr<EnveInstance> instance(new EnveInstance());
+
+    // Get mesh (shared with the other blocks), if ENVE_GROUND_ASYNC is set to 1
+    // the simulation starts on the back-up flat ground while the mesh is loading
+    instance->mesh = enve_sfun_mesh(mesh_path, pose);
+    char *mesh_async_env = getenv("ENVE_GROUND_ASYNC");
+    if (mesh_async_env == NULL || std::string(mesh_async_env) != "1")
+      {instance->mesh->get();}
 
     // Build flat
-    enve::ground::flat *flat = new enve::ground::flat(
+    instance->flat.reset(new enve::ground::flat(
       *FlatFrictionPar, acme::point(0.0, 0.0, *FlatHeightPar), acme::vec3(0.0, 0.0, 1.0)
-    );
+    ));
 
     // Build shell
-    enve::shell *shell = new enve::shell(
+    instance->shell.reset(new enve::shell(
       *SizePar,
       *Rx,
       *Mx,
       *Ry,
       *My,
       *Ly
-    );
+    ));
 
-    // Store pointers
-    MeshPtr  = static_cast<void *>(mesh);
-    FlatPtr  = static_cast<void *>(flat);
-    ShellPtr = static_cast<void *>(shell);
+    // Store block instance pointer
+    WorkPtr[0] = static_cast<void *>(instance.release());
 
     #undef CMD
   }
 
   void
   enve_sfun_out(
+          void         **WorkPtr,
     const EnveInputBus  *InputBus,
           EnveOutputBus *OutputBus,
     const EnveRealPar   *method,
@@ -114,9 +177,11 @@ extern "C"
   {
     #define CMD "enve_sfun_out(...): "
 
-    enve::ground::mesh *mesh  = static_cast<enve::ground::mesh *>(MeshPtr);
-    enve::ground::flat *flat  = static_cast<enve::ground::flat *>(FlatPtr);
-    enve::shell        *shell = static_cast<enve::shell *>(ShellPtr);
+    EnveInstance *instance = static_cast<EnveInstance *>(WorkPtr[0]);
+    ENVE_ASSERT(instance != nullptr, CMD "block instance not initialized.");
+    enve::ground::mesh::future const *mesh  = instance->mesh.get();
+    enve::ground::flat               *flat  = instance->flat.get();
+    enve::shell                      *shell = instance->shell.get();
 
     // Store temporaries
     int size = shell->size();
@@ -143,15 +208,10 @@ extern "C"
     // Use back-up plane for setup routine
     if (*FlatEnablePar == 0)
     {
-      // Update and check if shell is in mesh
-      OutputBus->InMesh = shell->setup(*mesh, tmp_affine, method_in);
-
-      // If no elements are detected under the tire shadows 'in_mesh = 0'
-      // and a setup with the back-up plane is called
-      if (!OutputBus->InMesh)
-      {
-        shell->setup(*flat, tmp_affine, method_in);
-      }
+      // Update and check if shell is in mesh, if the mesh is still loading or
+      // no elements are detected under the tire shadows 'in_mesh = 0' and a
+      // setup with the back-up plane is called
+      OutputBus->InMesh = shell->setup(*mesh, *flat, tmp_affine, method_in);
     }
     else if (*FlatEnablePar == 1)
     {
@@ -211,13 +271,15 @@ extern "C"
   }
 
   void
-  enve_sfun_end(void)
+  enve_sfun_end(
+    void **WorkPtr
+  )
   {
     #define CMD "enve_sfun_end(...): "
 
-    //delete static_cast<enve::ground::mesh *>(MeshPtr);
-    //delete static_cast<enve::ground::flat *>(FlatPtr);
-    //delete static_cast<enve::flat *>(ShellPtr);
+    // Release the block instance, the mesh is freed with the last block using it
+    delete static_cast<EnveInstance *>(WorkPtr[0]);
+    WorkPtr[0] = nullptr;
 
     #undef CMD
   }
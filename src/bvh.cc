@@ -0,0 +1,429 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: bvh.cc
+///
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "enve.hh"
+
+using namespace acme;
+
+namespace enve
+{
+
+  /*\
+   |   _           _
+   |  | |____   __| |__
+   |  | '_ \ \ / /| '_ \
+   |  | |_) \ V / | | | |
+   |  |_.__/ \_/  |_| |_|
+   |
+  \*/
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bvh::bvh(void)
+    : m_mark(0)
+  {
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  bvh::clear(void)
+  {
+    this->m_nodes.clear();
+    this->m_boxes.clear();
+    this->m_items.clear();
+    this->m_leaves.clear();
+    this->m_dirty.clear();
+    this->m_marks.clear();
+    this->m_mark = 0;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  bvh::isEmpty(void)
+    const
+  {
+    return this->m_nodes.empty();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  size_t
+  bvh::size(void)
+    const
+  {
+    return this->m_items.size();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  std::vector<bvh::node> const &
+  bvh::nodes(void)
+    const
+  {
+    return this->m_nodes;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  aabb
+  bvh::bbox(void)
+    const
+  {
+    if (this->m_nodes.empty())
+      {return aabb();}
+    real_storage const * box = this->m_nodes[0].box;
+    return aabb(box[0], box[1], box[2], box[3], box[4], box[5]);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  bvh::build(
+    std::vector<real> const & boxes,
+    size_t                    leaf_size
+  )
+  {
+    #define CMD "enve::bvh::build(...): "
+
+    ENVE_ASSERT(boxes.size() % 6 == 0,
+      CMD "boxes must be given as 6 coordinates per item.");
+    ENVE_ASSERT(boxes.size() / 6 < size_t(NONE_INDEX),
+      CMD "too many items for 32-bit indices.");
+    ENVE_ASSERT(leaf_size > 0,
+      CMD "leaf size must be positive.");
+
+    this->clear();
+    std::uint32_t size = std::uint32_t(boxes.size() / 6);
+    if (size == 0)
+      {return;}
+
+    this->m_boxes.resize(boxes.size());
+    for (size_t k = 0; k < boxes.size(); ++k)
+      {this->m_boxes[k] = outwards(boxes[k], k % 6 < 3);}
+    this->m_items.resize(size);
+    this->m_leaves.resize(size);
+    for (std::uint32_t i = 0; i < size; ++i)
+      {this->m_items[i] = i;}
+
+    // A binary tree with leaves of at least one item has less than 2*size nodes
+    this->m_nodes.reserve(2 * size);
+    this->m_nodes.push_back(node());
+    this->m_nodes[0].parent = NONE_INDEX;
+    this->buildNode(0, 0, size, leaf_size);
+    this->m_marks.assign(this->m_nodes.size(), std::uint32_t(0));
+
+    #undef CMD
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  bvh::update(
+    size_t         i,
+    aabb   const & box
+  )
+  {
+    #define CMD "enve::bvh::update(...): "
+
+    ENVE_ASSERT(i < this->size(),
+      CMD "item index out of range.");
+    ENVE_ASSERT(!this->isShrunk(),
+      CMD "shrunk tree cannot be updated.");
+
+    real_storage * item = &this->m_boxes[6 * i];
+    item[0] = outwards(box.min().x(), true);  item[1] = outwards(box.min().y(), true);
+    item[2] = outwards(box.min().z(), true);  item[3] = outwards(box.max().x(), false);
+    item[4] = outwards(box.max().y(), false); item[5] = outwards(box.max().z(), false);
+
+    // Mark the item leaf (once per refit)
+    std::uint32_t leaf = this->m_leaves[i];
+    if (this->m_marks[leaf] != this->m_mark + 1)
+    {
+      this->m_marks[leaf] = this->m_mark + 1;
+      this->m_dirty.push_back(leaf);
+    }
+
+    #undef CMD
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  bvh::refit(void)
+  {
+    if (this->m_dirty.empty())
+      {return;}
+
+    // Mark the ancestors of the updated leaves (each node once)
+    std::uint32_t mark = this->m_mark + 1;
+    for (size_t k = 0; k < this->m_dirty.size(); ++k)
+    {
+      std::uint32_t parent = this->m_nodes[this->m_dirty[k]].parent;
+      if (parent != NONE_INDEX && this->m_marks[parent] != mark)
+      {
+        this->m_marks[parent] = mark;
+        this->m_dirty.push_back(parent);
+      }
+    }
+
+    // Children are stored after their parent, refit from the last node
+    std::sort(this->m_dirty.begin(), this->m_dirty.end(), std::greater<std::uint32_t>());
+    for (size_t k = 0; k < this->m_dirty.size(); ++k)
+      {this->updateNode(this->m_dirty[k]);}
+    this->m_dirty.clear();
+
+    // Refresh the marks (reset on overflow)
+    if (++this->m_mark == NONE_INDEX - 1)
+    {
+      this->m_marks.assign(this->m_nodes.size(), std::uint32_t(0));
+      this->m_mark = 0;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  bvh::shrink(void)
+  {
+    // The nodes storage was reserved for the single item leaves worst case
+    std::vector<node>(this->m_nodes).swap(this->m_nodes);
+    std::vector<real_storage>().swap(this->m_boxes);
+    std::vector<std::uint32_t>().swap(this->m_leaves);
+    std::vector<std::uint32_t>().swap(this->m_dirty);
+    std::vector<std::uint32_t>().swap(this->m_marks);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  bvh::isShrunk(void)
+    const
+  {
+    return !this->m_items.empty() && this->m_boxes.empty();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  footprint
+  bvh::memoryUsage(void)
+    const
+  {
+    footprint usage;
+    usage.nodes   = capacityBytes(this->m_nodes);
+    usage.boxes   = capacityBytes(this->m_boxes);
+    usage.indices = capacityBytes(this->m_items) + capacityBytes(this->m_leaves) +
+                    capacityBytes(this->m_dirty) + capacityBytes(this->m_marks);
+    return usage;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  bvh::intersection(
+    aabb                   const & box,
+    std::vector<std::uint32_t>   & items
+  )
+    const
+  {
+    items.clear();
+    if (this->m_nodes.empty())
+      {return false;}
+
+    real const b[6] = {box.min().x(), box.min().y(), box.min().z(),
+                       box.max().x(), box.max().y(), box.max().z()};
+    #define ENVE_BVH_OVERLAP(X) \
+      (X[0] <= b[3] && X[3] >= b[0] && X[1] <= b[4] && X[4] >= b[1] && X[2] <= b[5] && X[5] >= b[2])
+
+    // Depth-first traversal with a fixed stack (the median split depth is below 64)
+    std::uint32_t stack[64];
+    size_t        top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+      node const & n = this->m_nodes[stack[--top]];
+      if (!ENVE_BVH_OVERLAP(n.box))
+        {continue;}
+      if (n.count == 0)
+      {
+        stack[top++] = n.first + 1;
+        stack[top++] = n.first;
+      }
+      else if (this->m_boxes.empty())
+      {
+        items.insert(items.end(), this->m_items.begin() + n.first, this->m_items.begin() + n.first + n.count);
+      }
+      else
+      {
+        for (std::uint32_t k = n.first; k < n.first + n.count; ++k)
+        {
+          std::uint32_t i = this->m_items[k];
+          if (ENVE_BVH_OVERLAP((&this->m_boxes[6 * i])))
+            {items.push_back(i);}
+        }
+      }
+    }
+
+    #undef ENVE_BVH_OVERLAP
+    return !items.empty();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  bvh::buildNode(
+    std::uint32_t index,
+    std::uint32_t first,
+    std::uint32_t count,
+    size_t        leaf_size
+  )
+  {
+    if (count <= leaf_size)
+    {
+      // Leaf node
+      this->m_nodes[index].first = first;
+      this->m_nodes[index].count = count;
+      for (std::uint32_t k = first; k < first + count; ++k)
+        {this->m_leaves[this->m_items[k]] = index;}
+      this->updateNode(index);
+      return;
+    }
+
+    // Doubled centroid coordinate (empty items with Not-a-Number boxes are put at zero)
+    std::vector<real_storage> const & boxes = this->m_boxes;
+    auto centroid = [&boxes](std::uint32_t i, size_t j)
+    {
+      real c = real(boxes[6 * i + j]) + real(boxes[6 * i + j + 3]);
+      return std::isfinite(c) ? c : real(0.0);
+    };
+
+    // Split at the median centroid along the largest centroids extent
+    real c_min[3] = {INFTY, INFTY, INFTY}, c_max[3] = {-INFTY, -INFTY, -INFTY};
+    for (std::uint32_t k = first; k < first + count; ++k)
+    {
+      for (size_t j = 0; j < 3; ++j)
+      {
+        real c   = centroid(this->m_items[k], j);
+        c_min[j] = std::min(c_min[j], c);
+        c_max[j] = std::max(c_max[j], c);
+      }
+    }
+    size_t axis = 0;
+    for (size_t j = 1; j < 3; ++j)
+      {if (c_max[j] - c_min[j] > c_max[axis] - c_min[axis]) {axis = j;}}
+    std::uint32_t half = count / 2;
+    std::nth_element(
+      this->m_items.begin() + first,
+      this->m_items.begin() + first + half,
+      this->m_items.begin() + first + count,
+      [&centroid, axis](std::uint32_t a, std::uint32_t b)
+        {return centroid(a, axis) < centroid(b, axis);});
+
+    // Internal node with contiguous children
+    std::uint32_t child = std::uint32_t(this->m_nodes.size());
+    this->m_nodes[index].first = child;
+    this->m_nodes[index].count = 0;
+    this->m_nodes.push_back(node());
+    this->m_nodes.push_back(node());
+    this->m_nodes[child].parent     = index;
+    this->m_nodes[child + 1].parent = index;
+    this->buildNode(child, first, half, leaf_size);
+    this->buildNode(child + 1, first + half, count - half, leaf_size);
+    this->updateNode(index);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  bvh::updateNode(
+    std::uint32_t i
+  )
+  {
+    node & n = this->m_nodes[i];
+    real_storage * box = n.box;
+    box[0] = box[1] = box[2] = real_storage(INFTY);
+    box[3] = box[4] = box[5] = real_storage(-INFTY);
+    if (n.count == 0)
+    {
+      // Internal node, merge the children boxes
+      for (std::uint32_t c = n.first; c < n.first + 2; ++c)
+      {
+        real_storage const * child = this->m_nodes[c].box;
+        for (size_t j = 0; j < 3; ++j)
+        {
+          box[j]     = std::min(box[j],     child[j]);
+          box[j + 3] = std::max(box[j + 3], child[j + 3]);
+        }
+      }
+    }
+    else
+    {
+      // Leaf node, merge the items boxes
+      for (std::uint32_t k = n.first; k < n.first + n.count; ++k)
+      {
+        real_storage const * item = &this->m_boxes[6 * this->m_items[k]];
+        for (size_t j = 0; j < 3; ++j)
+        {
+          box[j]     = std::min(box[j],     item[j]);
+          box[j + 3] = std::max(box[j + 3], item[j + 3]);
+        }
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_storage
+  bvh::outwards(
+    real value,
+    bool lower
+  )
+  {
+    real_storage rounded = real_storage(value);
+    if (lower && real(rounded) > value)
+      {rounded = std::nextafter(rounded, -std::numeric_limits<real_storage>::infinity());}
+    else if (!lower && real(rounded) < value)
+      {rounded = std::nextafter(rounded, std::numeric_limits<real_storage>::infinity());}
+    return rounded;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: bvh.cc
+///
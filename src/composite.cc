@@ -0,0 +1,442 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: composite.cc
+///
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "enve.hh"
+
+using namespace acme;
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |                                      _ _
+     |    ___ ___  _ __ ___  _ __   ___  ___(_) |_ ___
+     |   / __/ _ \| '_ ` _ \| '_ \ / _ \/ __| | __/ _ \
+     |  | (_| (_) | | | | | | |_) | (_) \__ \ | ||  __/
+     |   \___\___/|_| |_| |_| .__/ \___/|___/_|\__\___|
+     |                      |_|
+    \*/
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    composite::composite(void)
+    {
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    composite::composite(
+      std::vector<std::string> const & paths,
+      affine                   const & pose
+    )
+    {
+      for (size_t i = 0; i < paths.size(); ++i)
+        {this->add(paths[i], pose);}
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    composite::size(void)
+      const
+    {
+      return this->m_tiles.size();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    footprint
+    composite::memoryUsage(void)
+      const
+    {
+      footprint usage(this->m_AABBtree.memoryUsage());
+      for (size_t i = 0; i < this->m_tiles.size(); ++i)
+      {
+        if (this->m_tiles[i])
+          {usage += this->m_tiles[i]->memoryUsage();}
+      }
+      usage.pointers += capacityBytes(this->m_tiles);
+      usage.other    += capacityBytes(this->m_sources) + capacityBytes(this->m_loading);
+      for (size_t i = 0; i < this->m_sources.size(); ++i)
+        {usage.other += this->m_sources[i].path.capacity();}
+      return usage;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    composite::add(
+      std::string const & path,
+      affine      const & pose
+    )
+    {
+      #define CMD "enve::composite::add(...): "
+
+      size_t i = this->add(path, aabb(), pose);
+      this->load(i);
+      return i;
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    composite::add(
+      std::string const & path,
+      aabb        const & bounds,
+      affine      const & pose
+    )
+    {
+      #define CMD "enve::composite::add(...): "
+
+      std::string extension = path.size() < 4 ? "" : path.substr(path.size() - 4, 4);
+      ENVE_ASSERT(extension == ".rdf" || extension == ".obj",
+        CMD "not a *.rdf or *.obj file.");
+
+      source tile;
+      tile.path   = path;
+      tile.pose   = pose;
+      tile.bounds = bounds;
+      this->m_sources.push_back(tile);
+      this->m_loading.push_back(mesh::future());
+      this->m_tiles.push_back(nullptr);
+      if (!bounds.min().hasNaN() && !bounds.max().hasNaN())
+        {this->index(this->m_tiles.size() - 1);}
+      return this->m_tiles.size() - 1;
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    composite::add(
+      mesh::ptr const & ground
+    )
+    {
+      #define CMD "enve::composite::add(...): "
+
+      ENVE_ASSERT(ground != nullptr,
+        CMD "null tile mesh.");
+      source tile;
+      tile.pose   = IDENTITY_AFFINE;
+      tile.bounds = ground->bbox();
+      this->m_sources.push_back(tile);
+      this->m_loading.push_back(mesh::future());
+      this->m_tiles.push_back(ground);
+      this->index(this->m_tiles.size() - 1);
+      return this->m_tiles.size() - 1;
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    composite::remove(
+      size_t i
+    )
+    {
+      #define CMD "enve::composite::remove(...): "
+
+      ENVE_ASSERT(i < this->m_tiles.size(),
+        CMD "tile index out of range.");
+
+      // Drop a tile still loading too
+      this->m_sources[i].bounds = aabb();
+      this->m_loading[i] = mesh::future();
+      this->m_tiles[i].reset();
+      this->index(i);
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    composite::unload(
+      size_t i
+    )
+    {
+      #define CMD "enve::composite::unload(...): "
+
+      ENVE_ASSERT(i < this->m_tiles.size(),
+        CMD "tile index out of range.");
+      ENVE_ASSERT(!this->m_sources[i].path.empty(),
+        CMD "in-memory tiles cannot be loaded again.");
+
+      // The loaded tile bounds become the expected ones
+      if (this->m_tiles[i])
+        {this->m_sources[i].bounds = this->m_tiles[i]->bbox();}
+      this->m_loading[i] = mesh::future();
+      this->m_tiles[i].reset();
+      this->index(i);
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    composite::load(
+      size_t i
+    )
+    {
+      #define CMD "enve::composite::load(...): "
+
+      ENVE_ASSERT(i < this->m_tiles.size(),
+        CMD "tile index out of range.");
+      if (this->isLoaded(i) || this->isLoading(i) || this->m_sources[i].path.empty())
+        {return;}
+      std::string path(this->m_sources[i].path);
+      affine      pose(this->m_sources[i].pose);
+      std::shared_ptr<std::promise<mesh::ptr>> loaded(std::make_shared<std::promise<mesh::ptr>>());
+      this->m_loading[i] = loaded->get_future().share();
+      std::thread([loaded, path, pose]() {
+        try
+          {loaded->set_value(composite::loadTile(path, pose));}
+        catch (...)
+          {loaded->set_exception(std::current_exception());}
+      }).detach();
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    composite::load(
+      size_t               i,
+      mesh::future const & loading
+    )
+    {
+      #define CMD "enve::composite::load(...): "
+
+      ENVE_ASSERT(i < this->m_tiles.size(),
+        CMD "tile index out of range.");
+      ENVE_ASSERT(!this->isLoaded(i) && !this->isLoading(i),
+        CMD "tile already loaded or loading.");
+      this->m_loading[i] = loading;
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    composite::wait(
+      size_t i
+    )
+    {
+      #define CMD "enve::composite::wait(...): "
+
+      ENVE_ASSERT(i < this->m_tiles.size(),
+        CMD "tile index out of range.");
+      if (!this->m_loading[i].valid())
+        {return;}
+      mesh::future loading(this->m_loading[i]);
+      this->m_loading[i] = mesh::future();
+      this->m_tiles[i]   = loading.get();
+      this->index(i);
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    composite::isLoaded(
+      size_t i
+    )
+      const
+    {
+      return this->m_tiles[i] != nullptr;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    composite::isLoading(
+      size_t i
+    )
+      const
+    {
+      return this->m_loading[i].valid();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    composite::source const &
+    composite::tileSource(
+      size_t i
+    )
+      const
+    {
+      return this->m_sources[i];
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    mesh::ptr
+    composite::loadTile(
+      std::string const & path,
+      affine      const & pose
+    )
+    {
+      #define CMD "enve::composite::loadTile(...): "
+
+      std::string extension = path.size() < 4 ? "" : path.substr(path.size() - 4, 4);
+      if (extension == ".rdf")
+        {return std::make_shared<mesh const>(path, pose);}
+      else if (extension == ".obj")
+        {return std::make_shared<mesh const>(path, real(1.0), pose);}
+      else
+        {ENVE_ERROR(CMD "not a *.rdf or *.obj file.");}
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    composite::update(void)
+    {
+      size_t count = 0;
+      for (size_t i = 0; i < this->m_loading.size(); ++i)
+      {
+        if (mesh::isReady(this->m_loading[i]))
+        {
+          this->wait(i);
+          ++count;
+        }
+      }
+      return count;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    composite::wait(void)
+    {
+      for (size_t i = 0; i < this->m_loading.size(); ++i)
+        {this->wait(i);}
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    composite::isReady(void)
+      const
+    {
+      for (size_t i = 0; i < this->m_loading.size(); ++i)
+      {
+        if (this->m_loading[i].valid())
+          {return false;}
+      }
+      return true;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    mesh::ptr const &
+    composite::operator[](
+      size_t i
+    )
+      const
+    {
+      return this->m_tiles[i];
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    composite::intersection(
+      aabb                       const & box,
+      std::vector<std::uint32_t>       & tiles
+    )
+      const
+    {
+      return this->m_AABBtree.intersection(box, tiles);
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    composite::index(
+      size_t i
+    )
+    {
+      // Loaded tiles use the mesh box, registered tiles their expected bounds
+      // and loading or removed tiles a Not-a-Number box that never intersects
+      aabb box(this->m_sources[i].bounds);
+      if (this->m_tiles[i])
+        {box = this->m_tiles[i]->bbox();}
+
+      if (i < this->m_AABBtree.size())
+      {
+        // Known slot, refit its top-level path
+        this->m_AABBtree.update(i, box);
+        this->m_AABBtree.refit();
+      }
+      else
+      {
+        // New slots, rebuild the top-level tree only
+        std::vector<real> boxes;
+        boxes.reserve(6 * this->m_tiles.size());
+        for (size_t j = 0; j < this->m_tiles.size(); ++j)
+        {
+          aabb tile_box(this->m_sources[j].bounds);
+          if (this->m_tiles[j])
+            {tile_box = this->m_tiles[j]->bbox();}
+          boxes.insert(boxes.end(), {tile_box.min().x(), tile_box.min().y(), tile_box.min().z(),
+                                     tile_box.max().x(), tile_box.max().y(), tile_box.max().z()});
+        }
+        this->m_AABBtree.build(boxes, 1);
+      }
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: composite.cc
+///
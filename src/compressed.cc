@@ -0,0 +1,302 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: compressed.cc
+///
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "enve.hh"
+
+using namespace acme;
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |                                                                  _
+     |    ___   ___   _ __ ___   _ __   _ __   ___  ___  ___   ___   __| |
+     |   / __| / _ \ | '_ ` _ \ | '_ \ | '__| / _ \/ __|/ __| / _ \ / _` |
+     |  | (__ | (_) || | | | | || |_) || |   |  __/\__ \\__ \|  __/| (_| |
+     |   \___| \___/ |_| |_| |_|| .__/ |_|    \___||___/|___/ \___| \__,_|
+     |                          |_|
+    \*/
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    compressed::compressed(void)
+      : m_origin(ZEROS_VEC3),
+        m_resolution(real(1.0e-3))
+    {
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    compressed::compressed(
+      triangleground::vecptr const & triangles,
+      real                           resolution
+    )
+      : compressed()
+    {
+      this->compress(triangles, resolution);
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    compressed::compressed(
+      mesh const & ground,
+      real         resolution
+    )
+      : compressed()
+    {
+      this->compress(ground.vecptrTriangleground(), resolution);
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    compressed::compress(
+      triangleground::vecptr const & triangles,
+      real                           resolution
+    )
+    {
+      #define CMD "enve::compressed::compress(...): "
+
+      ENVE_ASSERT(resolution > real(0.0),
+        CMD "resolution must be positive.");
+
+      this->clear();
+      this->m_resolution = resolution;
+      size_t size = triangles.size();
+      if (size == 0)
+        {return;}
+
+      // Quantization origin at the mesh bounding box minimum
+      point lower(triangles[0]->bbox().min()), upper(triangles[0]->bbox().max());
+      for (size_t i = 1; i < size; ++i)
+      {
+        lower = lower.cwiseMin(triangles[i]->bbox().min());
+        upper = upper.cwiseMax(triangles[i]->bbox().max());
+      }
+      ENVE_ASSERT((upper - lower).maxCoeff() / resolution < real(std::numeric_limits<std::int32_t>::max()),
+        CMD "mesh too large for the given resolution.");
+      this->m_origin = lower;
+
+      // Quantize the vertices and collect the decoded triangles boxes
+      std::vector<real> boxes(6 * size);
+      this->m_vertices.resize(9 * size);
+      this->m_friction.resize(size);
+      for (size_t i = 0; i < size; ++i)
+      {
+        triangleground const & triangle = *triangles[i];
+        std::int32_t * packed = &this->m_vertices[9 * i];
+        for (size_t j = 0; j < 3; ++j)
+        {
+          vec3 offset((triangle.vertex(j) - lower) / resolution);
+          packed[3*j]   = std::int32_t(std::llround(offset.x()));
+          packed[3*j+1] = std::int32_t(std::llround(offset.y()));
+          packed[3*j+2] = std::int32_t(std::llround(offset.z()));
+        }
+        this->m_friction[i] = float(triangle.friction());
+        point v0(this->vertex(i, 0)), v1(this->vertex(i, 1)), v2(this->vertex(i, 2));
+        point box_min(v0.cwiseMin(v1).cwiseMin(v2)), box_max(v0.cwiseMax(v1).cwiseMax(v2));
+        std::copy(box_min.data(), box_min.data() + 3, &boxes[6 * i]);
+        std::copy(box_max.data(), box_max.data() + 3, &boxes[6 * i + 3]);
+      }
+
+      // Static tree with larger leaves, the items are filtered on the fly
+      this->m_AABBtree.build(boxes, 8);
+      this->m_AABBtree.shrink();
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    compressed::clear(void)
+    {
+      this->m_vertices.clear();
+      this->m_friction.clear();
+      this->m_AABBtree.clear();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    compressed::size(void)
+      const
+    {
+      return this->m_friction.size();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    footprint
+    compressed::memoryUsage(void)
+      const
+    {
+      footprint usage(this->m_AABBtree.memoryUsage());
+      usage.vertices = capacityBytes(this->m_vertices) + capacityBytes(this->m_friction);
+      return usage;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    real
+    compressed::resolution(void)
+      const
+    {
+      return this->m_resolution;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    aabb
+    compressed::bbox(void)
+      const
+    {
+      return this->m_AABBtree.bbox();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    point
+    compressed::vertex(
+      size_t i,
+      size_t j
+    )
+      const
+    {
+      std::int32_t const * packed = &this->m_vertices[9 * i + 3 * j];
+      return this->m_origin + this->m_resolution * vec3(packed[0], packed[1], packed[2]);
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    real
+    compressed::friction(
+      size_t i
+    )
+      const
+    {
+      return real(this->m_friction[i]);
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    triangleground::ptr
+    compressed::decode(
+      size_t i
+    )
+      const
+    {
+      return std::make_shared<triangleground const>(
+        integer(i), this->friction(i), this->vertex(i, 0), this->vertex(i, 1), this->vertex(i, 2)
+      );
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    compressed::decode(
+      size_t           i,
+      triangleground & triangle
+    )
+      const
+    {
+      triangle.copy(triangleground(
+        integer(i), this->friction(i), this->vertex(i, 0), this->vertex(i, 1), this->vertex(i, 2)
+      ));
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    compressed::decode(
+      size_t         i,
+      real_storage * packed,
+      point  const & reference
+    )
+      const
+    {
+      std::int32_t const * quantized = &this->m_vertices[9 * i];
+      vec3 offset(this->m_origin - reference);
+      for (size_t k = 0; k < 9; ++k)
+        {packed[k] = real_storage(offset[k % 3] + this->m_resolution * quantized[k]);}
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    compressed::intersection(
+      aabb                   const & box,
+      triangleground::vecidx       & triangles
+    )
+      const
+    {
+      #define CMD "enve::compressed::intersection(...): "
+
+      // Leaves items are filtered by their decoded bounding box
+      this->m_AABBtree.intersection(box, triangles);
+      vec3 lower((box.min() - this->m_origin) / this->m_resolution);
+      vec3 upper((box.max() - this->m_origin) / this->m_resolution);
+      size_t size = 0;
+      for (size_t k = 0; k < triangles.size(); ++k)
+      {
+        std::int32_t const * v = &this->m_vertices[9 * triangles[k]];
+        bool overlap = true;
+        for (size_t j = 0; j < 3 && overlap; ++j)
+        {
+          std::int32_t v_min = std::min(v[j], std::min(v[j+3], v[j+6]));
+          std::int32_t v_max = std::max(v[j], std::max(v[j+3], v[j+6]));
+          overlap = real(v_min) <= upper[j] && real(v_max) >= lower[j];
+        }
+        if (overlap)
+          {triangles[size++] = triangles[k];}
+      }
+      triangles.resize(size);
+      return size > 0;
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: compressed.cc
+///
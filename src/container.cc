@@ -0,0 +1,274 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: container.cc
+///
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "enve.hh"
+
+using namespace acme;
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |                   _        _
+     |    ___ ___  _ __ | |_ __ _(_)_ __   ___ _ __
+     |   / __/ _ \| '_ \| __/ _` | | '_ \ / _ \ '__|
+     |  | (_| (_) | | | | || (_| | | | | |  __/ |
+     |   \___\___/|_| |_|\__\__,_|_|_| |_|\___|_|
+     |
+    \*/
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    container::~container(void)
+    {
+      std::shared_future<void> loading;
+      {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        loading = this->m_loading;
+      }
+      if (loading.valid())
+        {loading.wait();}
+      {
+        std::lock_guard<std::mutex> lock(this->m_retiring);
+        this->m_stop = true;
+      }
+      this->m_wakeup.notify_one();
+      this->m_reaper.join();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    container::container(void)
+      : m_version(0),
+        m_released(0),
+        m_stop(false)
+    {
+      this->m_reaper = std::thread(&container::reap, this);
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    container::container(
+      mesh::ptr const & ground
+    )
+      : m_mesh(ground),
+        m_version(1),
+        m_released(0),
+        m_stop(false)
+    {
+      this->m_reaper = std::thread(&container::reap, this);
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    mesh::ptr
+    container::get(void)
+      const
+    {
+      return std::atomic_load(&this->m_mesh);
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    container::publish(
+      mesh::ptr const & ground
+    )
+    {
+      this->retire(std::atomic_exchange(&this->m_mesh, ground));
+      ++this->m_version;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    container::load(
+      std::string const & path,
+      affine      const & pose
+    )
+    {
+      this->enqueue([path, pose]() {
+        return mesh::ptr(std::make_shared<mesh const>(path, pose));
+      });
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    container::load(
+      std::string const & path,
+      real                friction,
+      affine      const & pose
+    )
+    {
+      this->enqueue([path, friction, pose]() {
+        return mesh::ptr(std::make_shared<mesh const>(path, friction, pose));
+      });
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    container::isLoading(void)
+      const
+    {
+      std::lock_guard<std::mutex> lock(this->m_mutex);
+      return this->m_loading.valid() &&
+        this->m_loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    container::wait(void)
+      const
+    {
+      std::shared_future<void> loading;
+      {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        loading = this->m_loading;
+      }
+      if (loading.valid())
+        {loading.get();}
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    container::version(void)
+      const
+    {
+      return this->m_version;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    container::retire(
+      mesh::ptr ground
+    )
+      const
+    {
+      if (!ground)
+        {return;}
+      {
+        // A snapshot already in the list keeps the mesh alive, so the handed
+        // reference can be dropped here
+        std::lock_guard<std::mutex> lock(this->m_retiring);
+        if (std::find(this->m_retired.begin(), this->m_retired.end(), ground) != this->m_retired.end())
+          {return;}
+        this->m_retired.push_back(std::move(ground));
+      }
+      this->m_wakeup.notify_one();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    container::released(void)
+      const
+    {
+      return this->m_released;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    container::enqueue(
+      std::function<mesh::ptr(void)> const & loader
+    )
+    {
+      std::lock_guard<std::mutex> lock(this->m_mutex);
+      std::shared_future<void> previous(this->m_loading);
+      this->m_loading = std::async(std::launch::async, [this, loader, previous]() {
+        // Load in parallel with the previous tasks but publish in order
+        mesh::ptr ground(loader());
+        if (previous.valid())
+          {previous.wait();}
+        this->publish(ground);
+      }).share();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    container::reap(void)
+    {
+      std::vector<mesh::ptr> expired;
+      std::unique_lock<std::mutex> lock(this->m_retiring);
+      while (!this->m_stop)
+      {
+        // Sleep until a snapshot is retired, then poll the ones still referenced elsewhere
+        if (this->m_retired.empty())
+          {this->m_wakeup.wait(lock, [this]() {return this->m_stop || !this->m_retired.empty();});}
+        else
+          {this->m_wakeup.wait_for(lock, std::chrono::milliseconds(20));}
+
+        // Only the retired list can still reach the unique snapshots (get() returns
+        // the published one), so they are moved out and destroyed without the lock
+        for (size_t i = 0; i < this->m_retired.size();)
+        {
+          if (this->m_retired[i].use_count() == 1)
+          {
+            expired.push_back(std::move(this->m_retired[i]));
+            this->m_retired[i] = std::move(this->m_retired.back());
+            this->m_retired.pop_back();
+          }
+          else
+            {++i;}
+        }
+        if (!expired.empty())
+        {
+          lock.unlock();
+          size_t count = expired.size();
+          expired.clear();
+          this->m_released += count;
+          lock.lock();
+        }
+      }
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: container.cc
+///
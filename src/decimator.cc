@@ -0,0 +1,472 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: decimator.cc
+///
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "enve.hh"
+
+using namespace acme;
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |       _              _                    _
+     |    __| |  ___   ___ (_) _ __ ___    __ _ | |_   ___   _ __
+     |   / _` | / _ \ / __|| || '_ ` _ \  / _` || __| / _ \ | '__|
+     |  | (_| ||  __/| (__ | || | | | | || (_| || |_ | (_) || |
+     |   \__,_| \___| \___||_||_| |_| |_| \__,_| \__| \___/ |_|
+     |
+    \*/
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    decimator::decimator(
+      triangleground::vecptr const & triangles
+    )
+      : m_size(0),
+        m_tolerance(real(0.0))
+    {
+      #define CMD "enve::decimator::decimator(...): "
+
+      ENVE_ASSERT(3 * triangles.size() < size_t(NONE_INDEX),
+        CMD "too many triangles for 32-bit indices.");
+
+      // Weld the triangles corners with equal coordinates
+      size_t size = triangles.size();
+      std::vector<std::uint32_t> corners(3 * size);
+      for (size_t k = 0; k < corners.size(); ++k)
+        {corners[k] = std::uint32_t(k);}
+      auto corner = [&triangles](std::uint32_t k) -> point const &
+        {return triangles[k / 3]->vertex(k % 3);};
+      std::sort(corners.begin(), corners.end(), [&corner](std::uint32_t a, std::uint32_t b) {
+        point const & p_a = corner(a);
+        point const & p_b = corner(b);
+        return std::lexicographical_compare(p_a.data(), p_a.data() + 3, p_b.data(), p_b.data() + 3);
+      });
+      this->m_faces.resize(size);
+      for (size_t k = 0; k < corners.size(); ++k)
+      {
+        if (k == 0 || corner(corners[k]) != corner(corners[k-1]))
+          {this->m_points.push_back(corner(corners[k]));}
+        this->m_faces[corners[k] / 3][corners[k] % 3] = std::uint32_t(this->m_points.size() - 1);
+      }
+
+      // Triangles data, stars and quadrics
+      size_t vertices = this->m_points.size();
+      this->m_quadrics.assign(vertices, quadric());
+      this->m_stamps.assign(vertices, std::uint32_t(0));
+      this->m_locked.assign(vertices, false);
+      this->m_removed.assign(vertices, false);
+      this->m_stars.resize(vertices);
+      this->m_friction.resize(size);
+      this->m_alive.assign(size, true);
+      this->m_covered.resize(size);
+      this->m_size = size;
+      for (size_t i = 0; i < size; ++i)
+      {
+        face const & f = this->m_faces[i];
+        this->m_friction[i] = triangles[i]->friction();
+        vec3 normal((this->m_points[f[1]] - this->m_points[f[0]]).cross(this->m_points[f[2]] - this->m_points[f[0]]));
+        real area = normal.norm() / real(2.0);
+        if (area > real(0.0))
+          {normal /= real(2.0) * area;}
+        real plane[4] = {normal.x(), normal.y(), normal.z(), -normal.dot(this->m_points[f[0]])};
+        quadric q;
+        for (size_t a = 0, k = 0; a < 4; ++a)
+          {for (size_t b = a; b < 4; ++b) {q[k++] = area * plane[a] * plane[b];}}
+        for (size_t j = 0; j < 3; ++j)
+        {
+          this->m_stars[f[j]].push_back(std::uint32_t(i));
+          for (size_t k = 0; k < q.size(); ++k)
+            {this->m_quadrics[f[j]][k] += q[k];}
+        }
+      }
+
+      // Each original vertex is covered by one of its triangles
+      for (size_t i = 0; i < vertices; ++i)
+        {this->m_covered[this->m_stars[i][0]].push_back(std::uint32_t(i));}
+
+      // Lock the boundary, non-manifold and friction boundary vertices
+      std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+      edges.reserve(3 * size);
+      for (size_t i = 0; i < size; ++i)
+      {
+        for (size_t j = 0; j < 3; ++j)
+        {
+          std::uint32_t a = this->m_faces[i][j], b = this->m_faces[i][(j+1) % 3];
+          edges.emplace_back(std::min(a, b), std::max(a, b));
+        }
+      }
+      std::sort(edges.begin(), edges.end());
+      for (size_t k = 0; k < edges.size();)
+      {
+        size_t n = k + 1;
+        while (n < edges.size() && edges[n] == edges[k])
+          {++n;}
+        if (n - k != 2)
+          {this->m_locked[edges[k].first] = this->m_locked[edges[k].second] = true;}
+        k = n;
+      }
+      for (size_t i = 0; i < vertices; ++i)
+      {
+        std::vector<std::uint32_t> const & star = this->m_stars[i];
+        for (size_t k = 1; k < star.size() && !this->m_locked[i]; ++k)
+          {this->m_locked[i] = this->m_friction[star[k]] != this->m_friction[star[0]];}
+      }
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    decimator::decimator(
+      mesh const & ground
+    )
+      : decimator(ground.vecptrTriangleground())
+    {
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    decimator::simplify(
+      real tolerance
+    )
+    {
+      #define CMD "enve::decimator::simplify(...): "
+
+      ENVE_ASSERT(tolerance >= this->m_tolerance,
+        CMD "tolerance cannot decrease between levels.");
+      this->m_tolerance = tolerance;
+
+      // Collapse candidates ordered by quadric error and then by edge length
+      struct candidate
+      {
+        real          cost;   // Quadric error
+        real          length; // Squared edge length
+        std::uint32_t u;      // Removed vertex
+        std::uint32_t v;      // Kept vertex
+        std::uint32_t stamp;  // Removed vertex star stamp
+        bool operator>(candidate const & c) const
+          {return cost > c.cost || (cost == c.cost && length > c.length);}
+      };
+      std::priority_queue<candidate, std::vector<candidate>, std::greater<candidate>> queue;
+      std::vector<std::uint32_t> adjacent, updated;
+      auto push = [this, &queue, &adjacent](std::uint32_t u) {
+        if (this->m_locked[u] || this->m_removed[u])
+          {return;}
+        this->neighbours(u, adjacent);
+        for (size_t k = 0; k < adjacent.size(); ++k)
+        {
+          std::uint32_t v = adjacent[k];
+          queue.push({this->cost(u, v), (this->m_points[u] - this->m_points[v]).squaredNorm(), u, v, this->m_stamps[u]});
+        }
+      };
+      for (std::uint32_t u = 0; u < this->m_points.size(); ++u)
+        {push(u);}
+
+      // Collapse until no candidate is left
+      while (!queue.empty())
+      {
+        candidate c(queue.top());
+        queue.pop();
+        if (this->m_removed[c.u] || this->m_removed[c.v] || this->m_stamps[c.u] != c.stamp)
+          {continue;}
+        if (!this->collapse(c.u, c.v))
+          {continue;}
+
+        // Refresh the candidates of the kept vertex and of its neighbours
+        this->neighbours(c.v, updated);
+        updated.push_back(c.v);
+        for (size_t k = 0; k < updated.size(); ++k)
+          {++this->m_stamps[updated[k]];}
+        for (size_t k = 0; k < updated.size(); ++k)
+          {push(updated[k]);}
+      }
+      return this->m_size;
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    decimator::size(void)
+      const
+    {
+      return this->m_size;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    real
+    decimator::tolerance(void)
+      const
+    {
+      return this->m_tolerance;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    triangleground::vecptr
+    decimator::triangles(void)
+      const
+    {
+      triangleground::vecptr triangles;
+      triangles.reserve(this->m_size);
+      for (size_t i = 0; i < this->m_faces.size(); ++i)
+      {
+        if (!this->m_alive[i])
+          {continue;}
+        face const & f = this->m_faces[i];
+        triangles.push_back(std::make_shared<triangleground const>(
+          integer(triangles.size()), this->m_friction[i],
+          this->m_points[f[0]], this->m_points[f[1]], this->m_points[f[2]]
+        ));
+      }
+      return triangles;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    decimator::write(
+      std::string const & path
+    )
+      const
+    {
+      #define CMD "enve::decimator::write(...): "
+
+      // Check if the file is an ".rdf" file
+      if (path.size() < 4 || path.substr(path.size() - 4, 4) != ".rdf")
+        {ENVE_ERROR(CMD "not a *.rdf file.");}
+
+      std::ofstream file(path);
+      if (!file.is_open())
+        {return false;}
+      file.precision(17);
+
+      // Renumber the kept vertices
+      std::vector<std::uint32_t> index(this->m_points.size(), NONE_INDEX);
+      std::uint32_t nodes = 0;
+      file
+        << "[NODES]" << std::endl
+        << "{ id  x_coord  y_coord  z_coord }" << std::endl;
+      for (size_t i = 0; i < this->m_points.size(); ++i)
+      {
+        if (this->m_removed[i] || this->m_stars[i].empty())
+          {continue;}
+        point const & p = this->m_points[i];
+        index[i] = nodes;
+        file << nodes++ << " " << p.x() << " " << p.y() << " " << p.z() << std::endl;
+      }
+      file
+        << "[ELEMENTS]" << std::endl
+        << "{ n1    n2    n3    mu }" << std::endl;
+      for (size_t i = 0; i < this->m_faces.size(); ++i)
+      {
+        if (!this->m_alive[i])
+          {continue;}
+        face const & f = this->m_faces[i];
+        file << index[f[0]] << " " << index[f[1]] << " " << index[f[2]] << " " << this->m_friction[i] << std::endl;
+      }
+      return file.good();
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    decimator::neighbours(
+      std::uint32_t                i,
+      std::vector<std::uint32_t> & adjacent
+    )
+      const
+    {
+      adjacent.clear();
+      std::vector<std::uint32_t> const & star = this->m_stars[i];
+      for (size_t k = 0; k < star.size(); ++k)
+      {
+        face const & f = this->m_faces[star[k]];
+        for (size_t j = 0; j < 3; ++j)
+        {
+          if (f[j] != i && std::find(adjacent.begin(), adjacent.end(), f[j]) == adjacent.end())
+            {adjacent.push_back(f[j]);}
+        }
+      }
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    real
+    decimator::cost(
+      std::uint32_t u,
+      std::uint32_t v
+    )
+      const
+    {
+      // Evaluate (Q_u + Q_v) at the kept vertex position
+      quadric const & q_u = this->m_quadrics[u];
+      quadric const & q_v = this->m_quadrics[v];
+      point   const & p   = this->m_points[v];
+      real x[4] = {p.x(), p.y(), p.z(), real(1.0)};
+      real error = real(0.0);
+      for (size_t a = 0, k = 0; a < 4; ++a)
+      {
+        for (size_t b = a; b < 4; ++b, ++k)
+          {error += (a == b ? real(1.0) : real(2.0)) * (q_u[k] + q_v[k]) * x[a] * x[b];}
+      }
+      return std::max(error, real(0.0));
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    decimator::collapse(
+      std::uint32_t u,
+      std::uint32_t v
+    )
+    {
+      // Link condition, an interior edge shares exactly two neighbours
+      std::vector<std::uint32_t> adjacent_u, adjacent_v;
+      this->neighbours(u, adjacent_u);
+      this->neighbours(v, adjacent_v);
+      size_t shared = 0;
+      for (size_t k = 0; k < adjacent_u.size(); ++k)
+        {shared += std::find(adjacent_v.begin(), adjacent_v.end(), adjacent_u[k]) != adjacent_v.end();}
+      if (shared != 2)
+        {return false;}
+
+      // Moved triangles must keep their orientation in the horizontal plane
+      auto area = [](point const & p_0, point const & p_1, point const & p_2)
+        {return (p_1.x() - p_0.x()) * (p_2.y() - p_0.y()) - (p_2.x() - p_0.x()) * (p_1.y() - p_0.y());};
+      std::vector<std::uint32_t> const & star = this->m_stars[u];
+      std::vector<std::uint32_t> moved;
+      std::vector<face>          faces;
+      for (size_t k = 0; k < star.size(); ++k)
+      {
+        face f(this->m_faces[star[k]]);
+        if (f[0] == v || f[1] == v || f[2] == v)
+          {continue;}
+        real area_old = area(this->m_points[f[0]], this->m_points[f[1]], this->m_points[f[2]]);
+        for (size_t j = 0; j < 3; ++j)
+          {f[j] = f[j] == u ? v : f[j];}
+        real area_new = area(this->m_points[f[0]], this->m_points[f[1]], this->m_points[f[2]]);
+        if (area_old * area_new <= real(0.0) || std::abs(area_new) < EPSILON_ENVE * std::abs(area_old))
+          {return false;}
+        moved.push_back(star[k]);
+        faces.push_back(f);
+      }
+
+      // The covered original vertices must stay within the tolerance
+      std::vector<std::uint32_t> owner;
+      for (size_t k = 0; k < star.size(); ++k)
+      {
+        std::vector<std::uint32_t> const & covered = this->m_covered[star[k]];
+        for (size_t c = 0; c < covered.size(); ++c)
+        {
+          point const & p = this->m_points[covered[c]];
+          size_t found = faces.size();
+          for (size_t m = 0; m < faces.size() && found == faces.size(); ++m)
+          {
+            point const & p_0 = this->m_points[faces[m][0]];
+            point const & p_1 = this->m_points[faces[m][1]];
+            point const & p_2 = this->m_points[faces[m][2]];
+            real a   = area(p_0, p_1, p_2);
+            real w_0 = area(p, p_1, p_2) / a;
+            real w_1 = area(p_0, p, p_2) / a;
+            real w_2 = real(1.0) - w_0 - w_1;
+            real eps = -EPSILON_ENVE;
+            if (w_0 >= eps && w_1 >= eps && w_2 >= eps &&
+                std::abs(w_0 * p_0.z() + w_1 * p_1.z() + w_2 * p_2.z() - p.z()) <= this->m_tolerance)
+              {found = m;}
+          }
+          if (found == faces.size())
+            {return false;}
+          owner.push_back(moved[found]);
+        }
+      }
+
+      // Apply the collapse
+      std::vector<std::uint32_t> covered;
+      for (size_t k = 0; k < star.size(); ++k)
+      {
+        covered.insert(covered.end(), this->m_covered[star[k]].begin(), this->m_covered[star[k]].end());
+        this->m_covered[star[k]].clear();
+      }
+      for (size_t c = 0; c < covered.size(); ++c)
+        {this->m_covered[owner[c]].push_back(covered[c]);}
+      std::vector<std::uint32_t> removed(star);
+      for (size_t k = 0; k < removed.size(); ++k)
+      {
+        std::uint32_t i = removed[k];
+        face & f = this->m_faces[i];
+        if (f[0] == v || f[1] == v || f[2] == v)
+        {
+          // Degenerate triangle, remove it from its vertices stars
+          this->m_alive[i] = false;
+          --this->m_size;
+          for (size_t j = 0; j < 3; ++j)
+          {
+            std::vector<std::uint32_t> & s = this->m_stars[f[j]];
+            s.erase(std::remove(s.begin(), s.end(), i), s.end());
+          }
+        }
+        else
+        {
+          for (size_t j = 0; j < 3; ++j)
+            {f[j] = f[j] == u ? v : f[j];}
+          this->m_stars[v].push_back(i);
+        }
+      }
+      this->m_stars[u].clear();
+      this->m_removed[u] = true;
+      for (size_t k = 0; k < this->m_quadrics[v].size(); ++k)
+        {this->m_quadrics[v][k] += this->m_quadrics[u][k];}
+      return true;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: decimator.cc
+///
@@ -49,7 +49,19 @@
   ENVE_ERROR(MSG)
 #endif
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <fstream>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
 
 #include "acme.hh"
 
@@ -87,14 +99,38 @@ using acme::IsApprox;
 // Static constants for convenience
 static real   const EPSILON_ENVE    = EPSILON_SQRT;          //!< Standard precision epsilon static constant value for enve
 static affine const IDENTITY_AFFINE = affine(IDENTITY_MAT4); //!< Identity affine constant object
+static std::uint32_t const NONE_INDEX = std::numeric_limits<std::uint32_t>::max(); //!< Invalid 32-bit index constant value
+
+namespace enve
+{
+#ifdef ENVE_SINGLE_PRECISION
+  typedef float      real_storage; //!< Real number type for packed ground storage and inner kernels
+#else
+  typedef acme::real real_storage; //!< Real number type for packed ground storage and inner kernels
+#endif
+} // namespace enve
 
 
+#include "enve/budget.hxx"
+#include "enve/bvh.hxx"
+#include "enve/composite.hxx"
+#include "enve/compressed.hxx"
+#include "enve/container.hxx"
+#include "enve/decimator.hxx"
 #include "enve/flat.hxx"
+#include "enve/footprint.hxx"
+#include "enve/generator.hxx"
+#include "enve/loadreport.hxx"
+#include "enve/lod.hxx"
 #include "enve/mesh.hxx"
 #include "enve/output.hxx"
+#include "enve/prefetcher.hxx"
 #include "enve/rib.hxx"
+#include "enve/scene.hxx"
 #include "enve/shape.hxx"
 #include "enve/shell.hxx"
+#include "enve/statistics.hxx"
+#include "enve/tracer.hxx"
 #include "enve/triangleground.hxx"
 
 #endif
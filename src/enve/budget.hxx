@@ -0,0 +1,80 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: budget.hxx
+///
+
+#ifndef INCLUDE_ENVE_BUDGET_HXX
+#define INCLUDE_ENVE_BUDGET_HXX
+
+namespace enve
+{
+
+  /*\
+   |   _               _            _
+   |  | |__  _   _  __| | __ _  ___| |_
+   |  | '_ \| | | |/ _` |/ _` |/ _ \ __|
+   |  | |_) | |_| | (_| | (_| |  __/ |_
+   |  |_.__/ \__,_|\__,_|\__, |\___|\__|
+   |                     |___/
+  \*/
+
+  //! Degradation applied by a budgeted setup (from the mildest to the most severe)
+  enum class degradation
+  {
+    none          = 0, //!< All ribs evaluated on the ground
+    ribs          = 1, //!< A subset of ribs evaluated, the others interpolated
+    extrapolation = 2  //!< No rib evaluated, last step results moved with the shell
+  }; // enum class degradation
+
+  //! Budgeted setup limits data class \n
+  //! The candidates search runs first and cannot be interrupted: its local
+  //! triangles are charged as tests and its time is counted, so a budget spent
+  //! by the search degrades the setup to extrapolation
+  struct budget {
+    size_t     tests = std::numeric_limits<size_t>::max(); //!< Maximum tests (local triangles and rib/triangle candidates)
+    acme::real time  = acme::INFTY;                        //!< Maximum setup time, candidates search included (s)
+  }; // struct budget
+
+  //! Budgeted setup report data class
+  struct report {
+    degradation level  = degradation::none; //!< Applied degradation
+    size_t      ribs   = size_t(0);         //!< Ribs evaluated on the ground
+    size_t      local  = size_t(0);         //!< Local triangles found by the candidates search
+    size_t      tests  = size_t(0);         //!< Tests performed (local triangles and rib/triangle candidates)
+    acme::real  search = acme::real(0.0);   //!< Candidates search time (s)
+    acme::real  time   = acme::real(0.0);   //!< Elapsed setup time, candidates search included (s)
+  }; // struct report
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: budget.hxx
+///
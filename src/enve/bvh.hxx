@@ -0,0 +1,182 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: bvh.hxx
+///
+
+#ifndef INCLUDE_ENVE_BVH_HXX
+#define INCLUDE_ENVE_BVH_HXX
+
+#include "footprint.hxx"
+
+namespace enve
+{
+
+  /*\
+   |   _           _
+   |  | |____   __| |__
+   |  | '_ \ \ / /| '_ \
+   |  | |_) \ V / | | | |
+   |  |_.__/ \_/  |_| |_|
+   |
+  \*/
+
+  //! Bounding volume hierarchy class \n
+  //! Binary tree of axis-aligned bounding boxes stored in flat arrays. Nodes are
+  //! stored in depth-first order (children after their parent), so the boxes of
+  //! the updated items can be refitted bottom-up without rebuilding the tree.
+  //! Boxes are stored in storage precision and rounded outwards, so that they
+  //! always contain the items. Empty items (Not-a-Number boxes) never intersect.
+  class bvh
+  {
+  public:
+    //! Tree node data structure
+    struct node
+    {
+      real_storage  box[6]; //!< Bounding box as [xmin ymin zmin xmax ymax zmax]
+      std::uint32_t first;  //!< First child node index (internal) or first item slot (leaf)
+      std::uint32_t count;  //!< Number of items (0 for internal nodes)
+      std::uint32_t parent; //!< Parent node index (NONE_INDEX for the root)
+    };
+
+  private:
+    std::vector<node>          m_nodes;  //!< Tree nodes (root first)
+    std::vector<real_storage>  m_boxes;  //!< Items bounding boxes (6 per item)
+    std::vector<std::uint32_t> m_items;  //!< Items indices sorted by leaf
+    std::vector<std::uint32_t> m_leaves; //!< Leaf node index of each item
+    std::vector<std::uint32_t> m_dirty;  //!< Nodes to be refitted
+    std::vector<std::uint32_t> m_marks;  //!< Nodes refit marks
+    std::uint32_t              m_mark;   //!< Current refit mark
+
+  public:
+    //! BVH class destructor
+    ~bvh(void) = default;
+
+    //! BVH class constructor
+    bvh(void);
+
+    //! Clear all the tree data
+    void
+    clear(void);
+
+    //! Check if the tree is empty
+    bool
+    isEmpty(void)
+    const;
+
+    //! Get the number of items
+    size_t
+    size(void)
+    const;
+
+    //! Get the tree nodes
+    std::vector<node> const &
+    nodes(void)
+    const;
+
+    //! Get the root bounding box
+    aabb
+    bbox(void)
+    const;
+
+    //! Build the tree from the items bounding boxes
+    void
+    build(
+      std::vector<real> const & boxes,        //!< Items bounding boxes (6 per item)
+      size_t                    leaf_size = 4 //!< Maximum number of items per leaf
+    );
+
+    //! Update the i-th item bounding box (applied to the tree at the next refit)
+    void
+    update(
+      size_t         i,  //!< Item index
+      aabb   const & box //!< New item bounding box
+    );
+
+    //! Refit the bounding boxes of the updated items leaves and their ancestors
+    void
+    refit(void);
+
+    //! Release the items bounding boxes, the refit data and the unused nodes
+    //! storage of a static tree \n
+    //! The tree can no longer be updated, and the intersection returns all the
+    //! items of the intersected leaves (to be filtered by the caller)
+    void
+    shrink(void);
+
+    //! Check if the tree has been shrunk
+    bool
+    isShrunk(void)
+    const;
+
+    //! Get the tree memory footprint (nodes, items boxes and indices)
+    footprint
+    memoryUsage(void)
+    const;
+
+    //! Collect the items whose bounding box intersects an external box
+    bool
+    intersection(
+      aabb                   const & box,  //!< External box
+      std::vector<std::uint32_t>   & items //!< Intersected items indices
+    ) const;
+
+  private:
+    //! Build the subtree of the items in the slots [first, first+count)
+    void
+    buildNode(
+      std::uint32_t index,    //!< Node index
+      std::uint32_t first,    //!< First item slot
+      std::uint32_t count,    //!< Number of items
+      size_t        leaf_size //!< Maximum number of items per leaf
+    );
+
+    //! Recompute the i-th node bounding box from its items or children
+    void
+    updateNode(
+      std::uint32_t i //!< Node index
+    );
+
+    //! Round a box coordinate to the storage precision, downwards for the
+    //! minimum and upwards for the maximum
+    static
+    real_storage
+    outwards(
+      real value, //!< Box coordinate
+      bool lower  //!< Box minimum flag
+    );
+
+  }; // class bvh
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: bvh.hxx
+///
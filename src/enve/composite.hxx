@@ -0,0 +1,236 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: composite.hxx
+///
+
+#ifndef INCLUDE_ENVE_COMPOSITE_HXX
+#define INCLUDE_ENVE_COMPOSITE_HXX
+
+#include "mesh.hxx"
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |                                      _ _
+     |    ___ ___  _ __ ___  _ __   ___  ___(_) |_ ___
+     |   / __/ _ \| '_ ` _ \| '_ \ / _ \/ __| | __/ _ \
+     |  | (_| (_) | | | | | | |_) | (_) \__ \ | ||  __/
+     |   \___\___/|_| |_| |_| .__/ \___/|___/_|\__\___|
+     |                      |_|
+    \*/
+
+    //! Multi-tile composite ground class \n
+    //! Each tile is a mesh loaded and indexed independently (in background), the
+    //! loaded tiles bounding boxes are indexed by a top-level AABB tree. Adding
+    //! or removing a tile never rebuilds the other tiles. Tiles can also be
+    //! registered with their bounds only and loaded on demand (out-of-core).
+    class composite
+    {
+    public:
+      //! Tile source data structure
+      struct source
+      {
+        std::string path;   //!< Path to the RDF/OBJ file (empty for in-memory tiles)
+        affine      pose;   //!< Scaling factor for the tile
+        aabb        bounds; //!< Expected tile bounds (Not-a-Number if unknown or removed)
+      };
+
+    private:
+      std::vector<source>       m_sources;  //!< Tiles sources
+      std::vector<mesh::future> m_loading;  //!< Tiles loading tasks (invalid once indexed)
+      std::vector<mesh::ptr>    m_tiles;    //!< Indexed tiles (nullptr if not loaded or removed)
+      bvh                       m_AABBtree; //!< Tiles top-level AABB tree
+
+    public:
+      //! Composite copy constructor
+      composite(composite const &) = delete;
+
+      //! Composite move constructor
+      composite(composite &&) = delete;
+
+      //! Composite assignment operator
+      composite & operator=(const composite &) = delete;
+
+      //! Composite move assignment operator
+      composite & operator=(composite &&) = delete;
+
+      //! Composite class destructor
+      ~composite(void) = default;
+
+      //! Composite class constructor
+      composite(void);
+
+      //! Composite class constructor (starts loading the tiles in parallel)
+      composite(
+        std::vector<std::string> const & paths,                 //!< Paths to the RDF/OBJ tiles files
+        affine                   const & pose = IDENTITY_AFFINE //!< Scaling factor for the tiles
+      );
+
+      //! Get the number of tiles slots (removed tiles included)
+      size_t
+      size(void)
+      const;
+
+      //! Get the composite memory footprint (loaded tiles and top-level tree)
+      footprint
+      memoryUsage(void)
+      const;
+
+      //! Start loading a RDF/OBJ tile in background and get its slot index
+      size_t
+      add(
+        std::string const & path,                  //!< Path to the RDF/OBJ file
+        affine      const & pose = IDENTITY_AFFINE //!< Scaling factor for the tile
+      );
+
+      //! Register a RDF/OBJ tile with its expected bounds without loading it and
+      //! get its slot index (the tile is loaded on demand with load())
+      size_t
+      add(
+        std::string const & path,                  //!< Path to the RDF/OBJ file
+        aabb        const & bounds,                //!< Expected tile bounds
+        affine      const & pose = IDENTITY_AFFINE //!< Scaling factor for the tile
+      );
+
+      //! Add an already loaded tile and get its slot index
+      size_t
+      add(
+        mesh::ptr const & ground //!< Tile mesh
+      );
+
+      //! Remove the i-th tile (a tile still loading is dropped without waiting)
+      void
+      remove(
+        size_t i //!< Tile slot index
+      );
+
+      //! Unload the i-th tile (or drop its loading) keeping it registered with
+      //! its bounds, so that it can be loaded again on demand
+      void
+      unload(
+        size_t i //!< Tile slot index
+      );
+
+      //! Start loading the i-th registered tile in background (if not loaded or loading) \n
+      //! The tile is loaded by a detached thread, so that removing or unloading
+      //! it before the end of the loading never waits for it
+      void
+      load(
+        size_t i //!< Tile slot index
+      );
+
+      //! Attach an external loading task to the i-th registered tile
+      void
+      load(
+        size_t               i,      //!< Tile slot index
+        mesh::future const & loading //!< Tile loading task
+      );
+
+      //! Wait for the i-th tile to be loaded and index it (loading errors are rethrown)
+      void
+      wait(
+        size_t i //!< Tile slot index
+      );
+
+      //! Check if the i-th tile is loaded and indexed
+      bool
+      isLoaded(
+        size_t i //!< Tile slot index
+      ) const;
+
+      //! Check if the i-th tile is loading
+      bool
+      isLoading(
+        size_t i //!< Tile slot index
+      ) const;
+
+      //! Get the i-th tile source
+      source const &
+      tileSource(
+        size_t i //!< Tile slot index
+      ) const;
+
+      //! Load a RDF/OBJ tile file (chosen by extension)
+      static
+      mesh::ptr
+      loadTile(
+        std::string const & path,                  //!< Path to the RDF/OBJ file
+        affine      const & pose = IDENTITY_AFFINE //!< Scaling factor for the tile
+      );
+
+      //! Index the tiles loaded since the last update (loading errors are rethrown) \n
+      //! Returns the number of newly indexed tiles
+      size_t
+      update(void);
+
+      //! Wait for all the tiles to be loaded and index them
+      void
+      wait(void);
+
+      //! Check if all the tiles are loaded and indexed
+      bool
+      isReady(void)
+      const;
+
+      //! Get the i-th tile (nullptr if loading or removed)
+      mesh::ptr const &
+      operator[](
+        size_t i //!< Tile slot index
+      ) const;
+
+      //! Intersect the top-level AABB tree with an external aabb object (the
+      //! registered tiles not loaded yet are intersected by their bounds)
+      bool
+      intersection(
+        aabb                       const & box,  //!< External aabb object
+        std::vector<std::uint32_t>       & tiles //!< Intersected tiles slot indices list
+      ) const;
+
+    private:
+      //! Set the i-th tile bounding box in the top-level AABB tree
+      void
+      index(
+        size_t i //!< Tile slot index
+      );
+
+    }; // class composite
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: composite.hxx
+///
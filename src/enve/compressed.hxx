@@ -0,0 +1,182 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: compressed.hxx
+///
+
+#ifndef INCLUDE_ENVE_COMPRESSED_HXX
+#define INCLUDE_ENVE_COMPRESSED_HXX
+
+#include "mesh.hxx"
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |                                                                  _
+     |    ___   ___   _ __ ___   _ __   _ __   ___  ___  ___   ___   __| |
+     |   / __| / _ \ | '_ ` _ \ | '_ \ | '__| / _ \/ __|/ __| / _ \ / _` |
+     |  | (__ | (_) || | | | | || |_) || |   |  __/\__ \\__ \|  __/| (_| |
+     |   \___| \___/ |_| |_| |_|| .__/ |_|    \___||___/|___/ \___| \__,_|
+     |                          |_|
+    \*/
+
+    //! Compressed mesh class \n
+    //! Static triangles mesh with vertices stored as 32-bit fixed-point offsets
+    //! from the mesh bounding box minimum (about 5 times less memory than a
+    //! mesh). Triangles are decoded on the fly only when intersected, and the
+    //! decoding error is below half the quantization resolution.
+    class compressed
+    {
+    public:
+      typedef std::shared_ptr<compressed const> ptr; //!< Shared pointer to a compressed mesh
+
+    private:
+      point                     m_origin;     //!< Quantization origin
+      real                      m_resolution; //!< Quantization resolution (m)
+      std::vector<std::int32_t> m_vertices;   //!< Quantized triangles vertices coordinates (9 per triangle)
+      std::vector<float>        m_friction;   //!< Triangles friction scaling coefficients
+      bvh                       m_AABBtree;   //!< Mesh AABB tree (shrunk)
+
+    public:
+      //! Compressed copy constructor
+      compressed(compressed const &) = delete;
+
+      //! Compressed move constructor
+      compressed(compressed &&) = delete;
+
+      //! Compressed assignment operator
+      compressed & operator=(const compressed &) = delete;
+
+      //! Compressed move assignment operator
+      compressed & operator=(compressed &&) = delete;
+
+      //! Compressed class destructor
+      ~compressed(void) = default;
+
+      //! Compressed class constructor
+      compressed(void);
+
+      //! Compressed class constructor
+      compressed(
+        triangleground::vecptr const & triangles,                //!< Ground triangles pointer vector list
+        real                           resolution = real(1.0e-3) //!< Quantization resolution (m)
+      );
+
+      //! Compressed class constructor
+      compressed(
+        mesh const & ground,                   //!< Mesh to be compressed
+        real         resolution = real(1.0e-3) //!< Quantization resolution (m)
+      );
+
+      //! Compress a triangles list and build the AABB tree
+      void
+      compress(
+        triangleground::vecptr const & triangles, //!< Ground triangles pointer vector list
+        real                           resolution //!< Quantization resolution (m)
+      );
+
+      //! Clear all compressed mesh data
+      void
+      clear(void);
+
+      //! Return number of triangles in the mesh
+      size_t
+      size(void)
+      const;
+
+      //! Get the compressed mesh memory footprint
+      footprint
+      memoryUsage(void)
+      const;
+
+      //! Get the quantization resolution (m)
+      real
+      resolution(void)
+      const;
+
+      //! Get the mesh axis-aligned bounding box
+      aabb
+      bbox(void)
+      const;
+
+      //! Decode the j-th vertex of the i-th triangle
+      point
+      vertex(
+        size_t i, //!< Triangle index
+        size_t j  //!< Vertex index
+      ) const;
+
+      //! Get the friction scaling coefficient of the i-th triangle
+      real
+      friction(
+        size_t i //!< Triangle index
+      ) const;
+
+      //! Decode the i-th triangle (its ID is the triangle index)
+      triangleground::ptr
+      decode(
+        size_t i //!< Triangle index
+      ) const;
+
+      //! Decode the i-th triangle in place (its ID is the triangle index)
+      void
+      decode(
+        size_t           i,       //!< Triangle index
+        triangleground & triangle //!< Output decoded triangle
+      ) const;
+
+      //! Decode the i-th triangle vertices as [x0 y0 z0 x1 y1 z1 x2 y2 z2] relative to a reference point
+      void
+      decode(
+        size_t         i,        //!< Triangle index
+        real_storage * packed,   //!< Output packed vertices coordinates (9 values)
+        point  const & reference //!< Reference point subtracted from the vertices
+      ) const;
+
+      //! Intersect the mesh AABB tree with an external aabb object (no temporaries are allocated)
+      bool
+      intersection(
+        aabb                   const & box,      //!< External aabb object
+        triangleground::vecidx       & triangles //!< Intersected triangleground indices list
+      ) const;
+
+    }; // class compressed
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: compressed.hxx
+///
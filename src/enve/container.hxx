@@ -0,0 +1,171 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: container.hxx
+///
+
+#ifndef INCLUDE_ENVE_CONTAINER_HXX
+#define INCLUDE_ENVE_CONTAINER_HXX
+
+#include "mesh.hxx"
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |                   _        _
+     |    ___ ___  _ __ | |_ __ _(_)_ __   ___ _ __
+     |   / __/ _ \| '_ \| __/ _` | | '_ \ / _ \ '__|
+     |  | (_| (_) | | | | || (_| | | | | |  __/ |
+     |   \___\___/|_| |_|\__\__,_|_|_| |_|\___|_|
+     |
+    \*/
+
+    //! Hot-swappable mesh container class \n
+    //! The published mesh is replaced atomically, readers take a snapshot with
+    //! get() and keep using it until they release it, so a replacement mesh can
+    //! be loaded in background and published without pausing the readers. \n
+    //! Replaced snapshots are handed back with retire() and destroyed by the
+    //! container background thread once no other reference is left.
+    class container
+    {
+    private:
+      mesh::ptr                       m_mesh;     //!< Published mesh (accessed atomically)
+      std::shared_future<void>        m_loading;  //!< Last background loading task
+      std::atomic<size_t>             m_version;  //!< Number of published meshes
+      mutable std::mutex              m_mutex;    //!< Loading tasks mutex
+      mutable std::vector<mesh::ptr>  m_retired;  //!< Retired snapshots waiting to be released
+      mutable std::mutex              m_retiring; //!< Retired snapshots mutex
+      mutable std::condition_variable m_wakeup;   //!< Release thread wake-up condition
+      std::atomic<size_t>             m_released; //!< Number of meshes released in background
+      bool                            m_stop;     //!< Release thread stop flag
+      std::thread                     m_reaper;   //!< Release thread
+
+    public:
+      //! Container copy constructor
+      container(container const &) = delete;
+
+      //! Container move constructor
+      container(container &&) = delete;
+
+      //! Container assignment operator
+      container & operator=(const container &) = delete;
+
+      //! Container move assignment operator
+      container & operator=(container &&) = delete;
+
+      //! Container class destructor (waits for the background loading and
+      //! stops the release thread)
+      ~container(void);
+
+      //! Container class constructor
+      container(void);
+
+      //! Container class constructor
+      container(
+        mesh::ptr const & ground //!< Mesh to be published
+      );
+
+      //! Get a snapshot of the published mesh (nullptr if none)
+      mesh::ptr
+      get(void)
+      const;
+
+      //! Atomically publish a new mesh
+      void
+      publish(
+        mesh::ptr const & ground //!< Mesh to be published
+      );
+
+      //! Load a replacement mesh from an RDF file in background and publish it
+      void
+      load(
+        std::string const & path,                  //!< Path to the RDF file
+        affine      const & pose = IDENTITY_AFFINE //!< Scaling factor for the mesh
+      );
+
+      //! Load a replacement mesh from an OBJ file in background and publish it
+      void
+      load(
+        std::string const & path,                  //!< Path to the OBJ file
+        real                friction,              //!< Friction scaling coefficient
+        affine      const & pose = IDENTITY_AFFINE //!< Scaling factor for the mesh
+      );
+
+      //! Check if a background loading is in progress
+      bool
+      isLoading(void)
+      const;
+
+      //! Wait for the background loading (loading errors are rethrown)
+      void
+      wait(void)
+      const;
+
+      //! Get the number of published meshes
+      size_t
+      version(void)
+      const;
+
+      //! Hand a replaced mesh snapshot to the release thread, which destroys
+      //! it once no other reference is left (so the caller never runs the last release)
+      void
+      retire(
+        mesh::ptr ground //!< Replaced mesh snapshot
+      ) const;
+
+      //! Get the number of meshes released by the release thread
+      size_t
+      released(void)
+      const;
+
+    private:
+      //! Queue a background loading task, publishing after the previous ones
+      void
+      enqueue(
+        std::function<mesh::ptr(void)> const & loader //!< Mesh loading function
+      );
+
+      //! Release thread loop
+      void
+      reap(void);
+
+    }; // class container
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: container.hxx
+///
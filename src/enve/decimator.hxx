@@ -0,0 +1,168 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: decimator.hxx
+///
+
+#ifndef INCLUDE_ENVE_DECIMATOR_HXX
+#define INCLUDE_ENVE_DECIMATOR_HXX
+
+#include "mesh.hxx"
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |       _              _                    _
+     |    __| |  ___   ___ (_) _ __ ___    __ _ | |_   ___   _ __
+     |   / _` | / _ \ / __|| || '_ ` _ \  / _` || __| / _ \ | '__|
+     |  | (_| ||  __/| (__ | || | | | | || (_| || |_ | (_) || |
+     |   \__,_| \___| \___||_||_| |_| |_| \__,_| \__| \___/ |_|
+     |
+    \*/
+
+    //! Error-bounded mesh decimation class \n
+    //! Offline simplification of road meshes by half-edge collapses ordered by
+    //! the quadric error metric. A collapse is accepted only if the vertical
+    //! deviation of the simplified surface from all the original vertices it
+    //! covers stays within the tolerance. Mesh boundary vertices and vertices
+    //! shared by triangles with different friction are never removed, so the
+    //! mesh outline and the friction boundaries are preserved exactly.
+    //! Successive calls with growing tolerances give progressive levels of detail.
+    class decimator
+    {
+    public:
+      typedef std::array<std::uint32_t, 3> face;    //!< Triangle vertices indices
+      typedef std::array<real, 10>         quadric; //!< Symmetric 4x4 quadric matrix upper triangle
+
+    private:
+      std::vector<point>                      m_points;    //!< Welded vertices (original positions)
+      std::vector<quadric>                    m_quadrics;  //!< Vertices accumulated quadrics
+      std::vector<std::uint32_t>              m_stamps;    //!< Vertices stars update stamps
+      std::vector<bool>                       m_locked;    //!< Vertices that cannot be removed
+      std::vector<bool>                       m_removed;   //!< Removed vertices flags
+      std::vector<std::vector<std::uint32_t>> m_stars;     //!< Alive triangles around each vertex
+      std::vector<face>                       m_faces;     //!< Triangles vertices indices
+      std::vector<real>                       m_friction;  //!< Triangles friction scaling coefficients
+      std::vector<bool>                       m_alive;     //!< Alive triangles flags
+      std::vector<std::vector<std::uint32_t>> m_covered;   //!< Original vertices covered by each triangle
+      size_t                                  m_size;      //!< Number of alive triangles
+      real                                    m_tolerance; //!< Current maximum vertical deviation (m)
+
+    public:
+      //! Decimator copy constructor
+      decimator(decimator const &) = delete;
+
+      //! Decimator move constructor
+      decimator(decimator &&) = delete;
+
+      //! Decimator assignment operator
+      decimator & operator=(const decimator &) = delete;
+
+      //! Decimator move assignment operator
+      decimator & operator=(decimator &&) = delete;
+
+      //! Decimator class destructor
+      ~decimator(void) = default;
+
+      //! Decimator class constructor (vertices are welded by exact coordinates)
+      decimator(
+        triangleground::vecptr const & triangles //!< Ground triangles pointer vector list
+      );
+
+      //! Decimator class constructor (vertices are welded by exact coordinates)
+      decimator(
+        mesh const & ground //!< Mesh to be decimated
+      );
+
+      //! Simplify the mesh until no collapse keeps the vertical deviation within
+      //! the tolerance and get the number of triangles left \n
+      //! Calling again with a larger tolerance continues from the current level
+      size_t
+      simplify(
+        real tolerance //!< Maximum vertical deviation (m)
+      );
+
+      //! Get the number of triangles of the current level
+      size_t
+      size(void)
+      const;
+
+      //! Get the current maximum vertical deviation (m)
+      real
+      tolerance(void)
+      const;
+
+      //! Get the triangles of the current level (IDs are the new indices)
+      triangleground::vecptr
+      triangles(void)
+      const;
+
+      //! Write the current level as a *.rdf file (friction is kept per element)
+      bool
+      write(
+        std::string const & path //!< Path to the file
+      ) const;
+
+    private:
+      //! Get the vertices adjacent to the i-th vertex
+      void
+      neighbours(
+        std::uint32_t                i,       //!< Vertex index
+        std::vector<std::uint32_t> & adjacent //!< Adjacent vertices indices
+      ) const;
+
+      //! Get the quadric error of the collapse of the vertex u into the vertex v
+      real
+      cost(
+        std::uint32_t u, //!< Removed vertex index
+        std::uint32_t v  //!< Kept vertex index
+      ) const;
+
+      //! Collapse the vertex u into the vertex v if the mesh stays valid and
+      //! within the tolerance
+      bool
+      collapse(
+        std::uint32_t u, //!< Removed vertex index
+        std::uint32_t v  //!< Kept vertex index
+      );
+
+    }; // class decimator
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: decimator.hxx
+///
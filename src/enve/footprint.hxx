@@ -0,0 +1,109 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: footprint.hxx
+///
+
+#ifndef INCLUDE_ENVE_FOOTPRINT_HXX
+#define INCLUDE_ENVE_FOOTPRINT_HXX
+
+namespace enve
+{
+
+ /*\
+  |    __                _                 _         _
+  |   / _|  ___    ___  | |_  _ __   _ __ (_) _ __  | |_
+  |  | |_  / _ \  / _ \ | __|| '_ \ | '__|| || '_ \ | __|
+  |  |  _|| (_) || (_) || |_ | |_) || |   | || | | || |_
+  |  |_|   \___/  \___/  \__|| .__/ |_|   |_||_| |_| \__|
+  |                          |_|
+ \*/
+
+  //! Memory footprint data class (bytes, allocated capacity, allocator overhead excluded)
+  struct footprint {
+    size_t triangles  = size_t(0); //!< Triangle objects (embedded bounding boxes excluded)
+    size_t control    = size_t(0); //!< Shared pointer control blocks
+    size_t pointers   = size_t(0); //!< Shared pointer handles
+    size_t vertices   = size_t(0); //!< Packed or quantized vertices and per-triangle attributes
+    size_t adjacency  = size_t(0); //!< Edge-neighbour indices
+    size_t boxes      = size_t(0); //!< Triangles and tree items bounding boxes
+    size_t nodes      = size_t(0); //!< Tree nodes
+    size_t indices    = size_t(0); //!< Tree items, leaves and refit indices
+    size_t candidates = size_t(0); //!< Shell candidates and local triangles buffers
+    size_t other      = size_t(0); //!< Everything else (ribs, outputs, scratch buffers)
+
+    //! Get the total bytes
+    size_t
+    total(void)
+    const
+    {
+      return this->triangles + this->control + this->pointers + this->vertices + this->adjacency +
+             this->boxes + this->nodes + this->indices + this->candidates + this->other;
+    }
+
+    //! Accumulate another footprint
+    footprint &
+    operator+=(
+      footprint const & rhs //!< Footprint to be added
+    )
+    {
+      this->triangles  += rhs.triangles;
+      this->control    += rhs.control;
+      this->pointers   += rhs.pointers;
+      this->vertices   += rhs.vertices;
+      this->adjacency  += rhs.adjacency;
+      this->boxes      += rhs.boxes;
+      this->nodes      += rhs.nodes;
+      this->indices    += rhs.indices;
+      this->candidates += rhs.candidates;
+      this->other      += rhs.other;
+      return *this;
+    }
+  }; // struct footprint
+
+  //! Get the bytes allocated by a vector
+  template <typename T>
+  size_t
+  capacityBytes(
+    std::vector<T> const & vec //!< Input vector
+  )
+  {
+    return vec.capacity() * sizeof(T);
+  }
+
+  //! Estimated bytes of a shared pointer control block (virtual table pointer and
+  //! use and weak counters, stored with the object by std::make_shared)
+  static size_t const CONTROL_BLOCK_BYTES = sizeof(void *) + 2 * sizeof(int);
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: footprint.hxx
+///
@@ -0,0 +1,204 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: generator.hxx
+///
+
+#ifndef INCLUDE_ENVE_GENERATOR_HXX
+#define INCLUDE_ENVE_GENERATOR_HXX
+
+#include "mesh.hxx"
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |                                          _
+     |    __ _   ___  _ __    ___  _ __   __ _ | |_   ___   _ __
+     |   / _` | / _ \| '_ \  / _ \| '__| / _` || __| / _ \ | '__|
+     |  | (_| ||  __/| | | ||  __/| |   | (_| || |_ | (_) || |
+     |   \__, | \___||_| |_| \___||_|    \__,_| \__| \___/ |_|
+     |   |___/
+    \*/
+
+    //! Procedural road mesh generator class \n
+    //! Builds a regular grid road (x-axis along the road, y-axis across it)
+    //! with ISO 8608 roughness, kerbs, potholes, cobblestones, banking and
+    //! friction patches. The same parameters and seed always give the same
+    //! road on every platform. Large roads can be streamed to file row by row
+    //! without building the mesh in memory.
+    class generator
+    {
+    public:
+      //! Rectangular friction patch data structure
+      struct patch
+      {
+        real x_min;    //!< Patch start along the road (m)
+        real x_max;    //!< Patch end along the road (m)
+        real y_min;    //!< Patch right side (m)
+        real y_max;    //!< Patch left side (m)
+        real friction; //!< Patch friction scaling coefficient
+      };
+
+      //! Pothole data structure
+      struct pothole
+      {
+        real x;      //!< Center position along the road (m)
+        real y;      //!< Center position across the road (m)
+        real radius; //!< Radius (m)
+        real depth;  //!< Depth (m)
+      };
+
+      //! Road generation parameters data structure
+      struct parameters
+      {
+        real               length             = real(100.0); //!< Road length (m)
+        real               width              = real(4.0);   //!< Road width (m)
+        real               spacing            = real(0.05);  //!< Grid spacing (m)
+        char               roughness          = 'A';         //!< ISO 8608 roughness class ('A' to 'H', or 0 for a smooth road)
+        size_t             waves              = 200;         //!< Number of harmonics of the roughness profiles
+        real               kerb_height        = real(0.0);   //!< Kerbs height on both sides (m)
+        real               kerb_width         = real(0.3);   //!< Kerbs width (m)
+        size_t             potholes           = 0;           //!< Number of randomly placed potholes
+        real               pothole_radius     = real(0.3);   //!< Maximum pothole radius (m)
+        real               pothole_depth      = real(0.05);  //!< Maximum pothole depth (m)
+        real               cobblestone_start  = real(0.0);   //!< Cobblestone section start along the road (m)
+        real               cobblestone_end    = real(0.0);   //!< Cobblestone section end along the road (m)
+        real               cobblestone_size   = real(0.1);   //!< Cobblestones size (m)
+        real               cobblestone_height = real(0.01);  //!< Maximum cobblestones height (m)
+        real               banking            = real(0.0);   //!< Banking (cross slope) angle (rad)
+        real               friction           = real(1.0);   //!< Base friction scaling coefficient
+        std::vector<patch> patches;                          //!< Friction patches (the last matching one wins)
+        std::uint32_t      seed               = 0;           //!< Random generator seed
+      };
+
+    private:
+      parameters           m_parameters; //!< Road generation parameters
+      size_t               m_nx;         //!< Number of grid cells along the road
+      size_t               m_ny;         //!< Number of grid cells across the road
+      std::vector<real>    m_right;      //!< Right track roughness profile at the grid columns (m)
+      std::vector<real>    m_left;       //!< Left track roughness profile at the grid columns (m)
+      std::vector<pothole> m_potholes;   //!< Potholes sorted along the road
+      std::vector<real>    m_stones;     //!< Cobblestones relative heights (hashed by stone)
+
+    public:
+      //! Generator copy constructor
+      generator(generator const &) = delete;
+
+      //! Generator move constructor
+      generator(generator &&) = delete;
+
+      //! Generator assignment operator
+      generator & operator=(const generator &) = delete;
+
+      //! Generator move assignment operator
+      generator & operator=(generator &&) = delete;
+
+      //! Generator class destructor
+      ~generator(void) = default;
+
+      //! Generator class constructor (the random features are drawn here)
+      generator(
+        parameters const & road //!< Road generation parameters
+      );
+
+      //! Get the road generation parameters
+      parameters const &
+      data(void)
+      const;
+
+      //! Get the number of triangles of the road mesh
+      size_t
+      size(void)
+      const;
+
+      //! Get the road height at a point (m)
+      real
+      height(
+        real x, //!< Position along the road (m)
+        real y  //!< Position across the road (m)
+      ) const;
+
+      //! Get the road friction scaling coefficient at a point
+      real
+      friction(
+        real x, //!< Position along the road (m)
+        real y  //!< Position across the road (m)
+      ) const;
+
+      //! Get the potholes
+      std::vector<pothole> const &
+      potholes(void)
+      const;
+
+      //! Generate the road triangles
+      triangleground::vecptr
+      triangles(void)
+      const;
+
+      //! Generate the road mesh
+      mesh::ptr
+      build(void)
+      const;
+
+      //! Stream the road to a *.rdf (friction per element) or *.obj file
+      bool
+      write(
+        std::string const & path //!< Path to the file
+      ) const;
+
+      //! Get the ISO 8608 displacement spectral density at the reference
+      //! spatial frequency of 0.1 cycles/m (m^3)
+      static
+      real
+      isoDensity(
+        char roughness //!< ISO 8608 roughness class ('A' to 'H')
+      );
+
+    private:
+      //! Get the j-th grid vertex across the road at the i-th grid column
+      point
+      vertex(
+        size_t i, //!< Grid column index
+        size_t j  //!< Grid row index
+      ) const;
+
+    }; // class generator
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: generator.hxx
+///
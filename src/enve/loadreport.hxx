@@ -0,0 +1,109 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: loadreport.hxx
+///
+
+#ifndef INCLUDE_ENVE_LOADREPORT_HXX
+#define INCLUDE_ENVE_LOADREPORT_HXX
+
+namespace enve
+{
+
+ /*\
+  |   _                    _                                  _
+  |  | |  ___    __ _   __| | _ __   ___  _ __    ___   _ __ | |_
+  |  | | / _ \  / _` | / _` || '__| / _ \| '_ \  / _ \ | '__|| __|
+  |  | || (_) || (_| || (_| || |   |  __/| |_) || (_) || |   | |_
+  |  |_| \___/  \__,_| \__,_||_|    \___|| .__/  \___/ |_|    \__|
+  |                                      |_|
+ \*/
+
+  //! Mesh loading report data class (times in seconds, memory in bytes)
+  struct loadreport {
+    std::string path;                             //!< Loaded file path (empty if built from triangles)
+    std::string format;                           //!< Loaded file format ("rdf", "obj" or empty)
+    size_t      bytes          = size_t(0);       //!< Bytes read from the file
+    size_t      lines          = size_t(0);       //!< Lines read from the file
+    size_t      nodes          = size_t(0);       //!< Nodes (vertices) counted
+    size_t      elements       = size_t(0);       //!< Elements (triangles) counted
+    acme::real  time_parse     = acme::real(0.0); //!< Time spent reading and parsing the file
+    acme::real  time_read      = acme::real(0.0); //!< Time spent reading the lines (ENVE_STATISTICS only)
+    acme::real  time_tokenize  = acme::real(0.0); //!< Time spent splitting the lines (ENVE_STATISTICS only)
+    acme::real  time_convert   = acme::real(0.0); //!< Time spent converting tokens into numbers (ENVE_STATISTICS only)
+    acme::real  time_construct = acme::real(0.0); //!< Time spent constructing the triangles (ENVE_STATISTICS only)
+    acme::real  time_reorder   = acme::real(0.0); //!< Time spent in the Morton reordering (tree build excluded)
+    acme::real  time_boxes     = acme::real(0.0); //!< Time spent collecting the triangles bounding boxes
+    acme::real  time_adjacency = acme::real(0.0); //!< Time spent packing the vertices and matching the neighbours
+    acme::real  time_tree      = acme::real(0.0); //!< Time spent building the AABB tree
+    acme::real  time_total     = acme::real(0.0); //!< Wall time of the whole load call
+    size_t      mesh_memory    = size_t(0);       //!< Loaded mesh memory footprint
+    size_t      peak_memory    = size_t(0);       //!< Process peak resident memory (0 if not available)
+
+    //! Get the parsing throughput (MB/s)
+    acme::real
+    throughput(void)
+    const
+    {
+      return this->time_parse > acme::real(0.0) ? acme::real(this->bytes) / acme::real(1.0e6) / this->time_parse : acme::real(0.0);
+    }
+
+    //! Print the report on a stream
+    void
+    print(
+      acme::out_stream & os //!< Output stream
+    ) const
+    {
+      os
+        << "Mesh load report" << (this->path.empty() ? "" : " (" + this->path + ")") << std::endl
+        << "\tBytes read     = " << this->bytes << " (" << this->lines << " lines)" << std::endl
+        << "\tThroughput     = " << this->throughput() << " MB/s" << std::endl
+        << "\tNodes          = " << this->nodes << std::endl
+        << "\tElements       = " << this->elements << std::endl
+        << "\tParsing        = " << this->time_parse << " s" << std::endl
+        << "\tReading        = " << this->time_read << " s" << std::endl
+        << "\tTokenizing     = " << this->time_tokenize << " s" << std::endl
+        << "\tConversion     = " << this->time_convert << " s" << std::endl
+        << "\tConstruction   = " << this->time_construct << " s" << std::endl
+        << "\tReordering     = " << this->time_reorder << " s" << std::endl
+        << "\tBounding boxes = " << this->time_boxes << " s" << std::endl
+        << "\tAdjacency      = " << this->time_adjacency << " s" << std::endl
+        << "\tTree build     = " << this->time_tree << " s" << std::endl
+        << "\tTotal          = " << this->time_total << " s" << std::endl
+        << "\tMesh memory    = " << this->mesh_memory << " B" << std::endl
+        << "\tPeak memory    = " << this->peak_memory << " B" << std::endl;
+    }
+  }; // struct loadreport
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: loadreport.hxx
+///
@@ -0,0 +1,117 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: lod.hxx
+///
+
+#ifndef INCLUDE_ENVE_LOD_HXX
+#define INCLUDE_ENVE_LOD_HXX
+
+#include "decimator.hxx"
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |   _             _
+     |  | |  ___    __| |
+     |  | | / _ \  / _` |
+     |  | || (_) || (_| |
+     |  |_| \___/  \__,_|
+     |
+    \*/
+
+    //! Multi level-of-detail mesh class \n
+    //! Stores a mesh and its progressively decimated versions, each with its
+    //! maximum vertical deviation from the original mesh. A shell can pick the
+    //! coarsest level within the tolerance allowed by its speed or rib size.
+    class lod
+    {
+    private:
+      std::vector<real>      m_tolerances; //!< Levels maximum vertical deviations (m)
+      std::vector<mesh::ptr> m_levels;     //!< Levels meshes (finest first)
+
+    public:
+      //! Lod copy constructor
+      lod(lod const &) = delete;
+
+      //! Lod move constructor
+      lod(lod &&) = delete;
+
+      //! Lod assignment operator
+      lod & operator=(const lod &) = delete;
+
+      //! Lod move assignment operator
+      lod & operator=(lod &&) = delete;
+
+      //! Lod class destructor
+      ~lod(void) = default;
+
+      //! Lod class constructor (the original mesh is the level 0)
+      lod(
+        mesh::ptr         const & ground,    //!< Original mesh
+        std::vector<real> const & tolerances //!< Increasing levels maximum vertical deviations (m)
+      );
+
+      //! Get the number of levels
+      size_t
+      size(void)
+      const;
+
+      //! Get the maximum vertical deviation of the i-th level (m)
+      real
+      tolerance(
+        size_t i //!< Level index
+      ) const;
+
+      //! Get the i-th level mesh
+      mesh::ptr const &
+      operator[](
+        size_t i //!< Level index
+      ) const;
+
+      //! Get the coarsest level mesh within a maximum vertical deviation
+      mesh::ptr const &
+      level(
+        real tolerance //!< Maximum vertical deviation (m)
+      ) const;
+
+    }; // class lod
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: lod.hxx
+///
@@ -32,6 +32,8 @@
 #ifndef INCLUDE_ENVE_MESH_HXX
 #define INCLUDE_ENVE_MESH_HXX
 
+#include "bvh.hxx"
+#include "loadreport.hxx"
 #include "triangleground.hxx"
 
 namespace enve
@@ -53,11 +55,21 @@ namespace enve
     class mesh
     {
     private:
-      triangleground::vecptr m_triangles; //!< Ground triangles pointers vector
-      aabb::vecptr           m_bboxes;    //!< Bounding boxes pointers vector
-      AABBtree::ptr          m_AABBtree;  //!< Mesh AABB tree
+      triangleground::vecptr    m_triangles;  //!< Ground triangles pointers vector
+      bvh                       m_AABBtree;   //!< Mesh AABB tree (refittable)
+      std::vector<real_storage> m_vertices;   //!< Packed triangles vertices coordinates (9 per triangle, relative to the origin, single precision only)
+      point                     m_origin;     //!< Packed vertices coordinates origin (mesh bounding box center)
+      triangleground::vecidx    m_neighbours; //!< Edge-neighbour triangles indices (3 per triangle)
+      triangleground::vecidx    m_components; //!< Edge-connected component index of each triangle
+      std::vector<aabb>         m_regions;    //!< Edge-connected components bounding boxes
+      std::uint64_t             m_generation; //!< Process-unique mesh generation
+      loadreport                m_report;     //!< Last load (or build) report
 
     public:
+      typedef std::shared_ptr<mesh const>             ptr;    //!< Shared pointer to mesh object
+      typedef std::shared_future<ptr>                 future; //!< Shared future to asynchronously loaded mesh object
+      typedef std::function<void(loadreport const &)> sink;   //!< Load reports sink
+
       //! Mesh copy constructor
       mesh(mesh const &) = delete;
 
@@ -83,17 +95,61 @@ namespace enve
 
       //! Mesh class constructor
       mesh(
-        std::string const & path,                  //!< Path to the RDF file
-        affine      const & pose = IDENTITY_AFFINE //!< Scaling factor for the mesh
+        std::string const & path,                     //!< Path to the RDF file
+        affine      const & pose   = IDENTITY_AFFINE, //!< Scaling factor for the mesh
+        bool                morton = false            //!< Reorder the triangles along a Z-order curve
       );
 
       //! Mesh class constructor
       mesh(
-        std::string const & path,                  //!< Path to the OBJ file
-        real                friction,              //!< Friction scaling coefficient
-        affine      const & pose = IDENTITY_AFFINE //!< Scaling factor for the mesh
+        std::string const & path,                     //!< Path to the OBJ file
+        real                friction,                 //!< Friction scaling coefficient
+        affine      const & pose   = IDENTITY_AFFINE, //!< Scaling factor for the mesh
+        bool                morton = false            //!< Reorder the triangles along a Z-order curve
+      );
+
+      //! Load the mesh from an RDF file in a background thread \n
+      //! Returns immediately, loading errors are rethrown by the future get()
+      static
+      future
+      loadAsync(
+        std::string const & path,                     //!< Path to the RDF file
+        affine      const & pose   = IDENTITY_AFFINE, //!< Scaling factor for the mesh
+        bool                morton = false            //!< Reorder the triangles along a Z-order curve
+      );
+
+      //! Load the mesh from an OBJ file in a background thread \n
+      //! Returns immediately, loading errors are rethrown by the future get()
+      static
+      future
+      loadAsync(
+        std::string const & path,                     //!< Path to the OBJ file
+        real                friction,                 //!< Friction scaling coefficient
+        affine      const & pose   = IDENTITY_AFFINE, //!< Scaling factor for the mesh
+        bool                morton = false            //!< Reorder the triangles along a Z-order curve
+      );
+
+      //! Check if an asynchronously loaded mesh is ready to be used
+      static
+      bool
+      isReady(
+        future const & ground //!< Asynchronously loaded mesh
       );
 
+      //! Set the sink receiving the report of every completed load (an empty sink disables it) \n
+      //! Loads print nothing, the sink is their only output (none by default). The
+      //! sink may be called from the loading threads of loadAsync()
+      static
+      void
+      setSink(
+        sink const & function //!< Load reports sink
+      );
+
+      //! Get the report of the last load (or AABB tree build)
+      loadreport const &
+      loadReport(void)
+      const;
+
       //! Copy mesh object
       void
       copy(
@@ -109,6 +165,50 @@ namespace enve
       vecptrTriangleground(void)
       const;
 
+      //! Get packed triangles vertices coordinates as [x0 y0 z0 x1 y1 z1 x2 y2 z2] per triangle \n
+      //! Coordinates are relative to origin(), so that single precision storage keeps
+      //! the resolution of the mesh extent and not of its distance from the world origin.
+      //! The packed copy is built only if ENVE_SINGLE_PRECISION is defined (empty
+      //! otherwise), as it duplicates the triangles vertices
+      std::vector<real_storage> const &
+      vecVertices(void)
+      const;
+
+      //! Get the packed vertices coordinates origin
+      point const &
+      origin(void)
+      const;
+
+      //! Get j-th edge-neighbour index of the i-th triangle (NONE_INDEX on the mesh boundary) \n
+      //! The j-th edge joins the vertices j and (j+1)%3
+      std::uint32_t
+      neighbour(
+        size_t i, //!< Triangle index
+        size_t j  //!< Edge index
+      ) const;
+
+      //! Get the edge-connected component index of the i-th triangle
+      std::uint32_t
+      component(
+        size_t i //!< Triangle index
+      ) const;
+
+      //! Get the edge-connected components bounding boxes
+      std::vector<aabb> const &
+      components(void)
+      const;
+
+      //! Get the mesh generation, a process-unique value renewed whenever the
+      //! triangles indices or their connectivity change (not by update())
+      std::uint64_t
+      generation(void)
+      const;
+
+      //! Get the mesh AABB tree
+      bvh const &
+      AABBtree(void)
+      const;
+
       //! Get i-th triangleground pointer
       triangleground::ptr
       ptrTriangleground(
@@ -132,19 +232,31 @@ namespace enve
       size(void)
       const;
 
+      //! Get the mesh axis-aligned bounding box
+      aabb
+      bbox(void)
+      const;
+
+      //! Get the mesh memory footprint (triangles shared with other meshes included)
+      footprint
+      memoryUsage(void)
+      const;
+
       //! Load ground data as a *.rdf file
       bool
       load(
-        std::string const & path,                  //!< Path to the file
-        affine      const & pose = IDENTITY_AFFINE //!< Scaling factor for the mesh
+        std::string const & path,                     //!< Path to the file
+        affine      const & pose   = IDENTITY_AFFINE, //!< Scaling factor for the mesh
+        bool                morton = false            //!< Reorder the triangles along a Z-order curve
       );
 
       //! Load ground data as a *.obj file
       bool
       load(
-        std::string const & path,                  //!< Path to the file
-        real                friction,              //!< Friction coefficient scaling factor
-        affine      const & pose = IDENTITY_AFFINE //!< Scaling factor for the mesh
+        std::string const & path,                     //!< Path to the file
+        real                friction,                 //!< Friction coefficient scaling factor
+        affine      const & pose   = IDENTITY_AFFINE, //!< Scaling factor for the mesh
+        bool                morton = false            //!< Reorder the triangles along a Z-order curve
       );
 
       //! Intersect the mesh AABBtree with an external aabb object pointer
@@ -154,14 +266,73 @@ namespace enve
         triangleground::vecptr       & triangles //!< Intersected triangleground vector list
       ) const;
 
+      //! Intersect the mesh AABBtree with an external aabb object pointer
+      bool
+      intersection(
+        aabb::ptr              const   box,      //!< External aabb object pointer
+        triangleground::vecidx       & triangles //!< Intersected triangleground indices list
+      ) const;
+
+      //! Intersect the mesh AABBtree with an external aabb object (no temporaries are allocated)
+      bool
+      intersection(
+        aabb                   const & box,      //!< External aabb object
+        triangleground::vecidx       & triangles //!< Intersected triangleground indices list
+      ) const;
+
       //! Build mesh AABBtree
       void
       buildAABBtree(void);
 
+      //! Reorder the triangles along a Z-order (Morton) curve of their centroids
+      //! and rebuild the AABBtree \n
+      //! The triangles are copied in a single block in the new order, so that
+      //! spatially close triangles become close in memory, while their IDs (the
+      //! file element indices for loaded meshes) are kept to map them back
+      void
+      reorder(void);
+
+      //! Update vertices and friction of a subset of triangles in place and refit
+      //! only the AABB tree nodes above them (the mesh connectivity is kept)
+      void
+      update(
+        triangleground::vecidx const & indices,  //!< Updated triangles indices
+        std::vector<point>     const & vertices, //!< New triangles vertices (3 per triangle)
+        std::vector<real>      const & friction  //!< New triangles friction scaling coefficients
+      );
+
     private:
-      //! Update the mesh bounding boxes pointers
+      //! Update the i-th triangle packed vertices coordinates
+      void
+      updateVertices(
+        size_t i //!< Triangle index
+      );
+
+      //! Update the mesh packed vertices coordinates
+      void
+      updateVertices(void);
+
+      //! Update the triangles edge-neighbours by matching shared edges vertices
+      //! and label their edge-connected components
       void
-      updateBBoxes(void);
+      updateNeighbours(void);
+
+      //! Get the process peak resident memory in bytes (0 if not available)
+      static
+      size_t
+      peakMemory(void);
+
+      //! Send the last load report to the sink
+      void
+      report(void)
+      const;
+
+      //! Get the 63-bit Morton code of a point with coordinates in [0,1]
+      static
+      std::uint64_t
+      mortonCode(
+        vec3 const & unit //!< Normalized point coordinates
+      );
 
       //! Split a string into a string array at a given token
       void
@@ -0,0 +1,167 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: prefetcher.hxx
+///
+
+#ifndef INCLUDE_ENVE_PREFETCHER_HXX
+#define INCLUDE_ENVE_PREFETCHER_HXX
+
+#include "composite.hxx"
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |                   __      _       _
+     |   _ __  _ __ ___ / _| ___| |_ ___| |__   ___ _ __
+     |  | '_ \| '__/ _ \ |_ / _ \ __/ __| '_ \ / _ \ '__|
+     |  | |_) | | |  __/  _|  __/ || (__| | | |  __/ |
+     |  | .__/|_|  \___|_|  \___|\__\___|_| |_|\___|_|
+     |  |_|
+    \*/
+
+    //! Predictive tiles prefetching service class \n
+    //! The registered tiles of a composite ground expected under a shell within
+    //! a time horizon (from its bounding box and velocity) are loaded by a
+    //! background I/O thread. The tiles needed by the current step and still
+    //! not loaded are loaded at once and counted as stalls. Above the residency
+    //! budget, the loaded tiles out of the horizon are unloaded (farthest first).
+    //! On destruction, the queued tiles are not loaded: their loading fails and
+    //! they are unloaded from the composite ground.
+    class prefetcher
+    {
+    public:
+      //! Prefetching metrics data structure
+      struct metrics
+      {
+        size_t requests   = size_t(0); //!< Tiles loading requests by prediction
+        size_t hits       = size_t(0); //!< Needed tiles already loaded
+        size_t stalls     = size_t(0); //!< Needed tiles waited for
+        real   stall_time = real(0.0); //!< Total time spent waiting for tiles (s)
+        size_t evictions  = size_t(0); //!< Tiles unloaded above the residency budget
+      };
+
+    private:
+      //! Tile loading job data structure
+      struct job
+      {
+        size_t                  index;   //!< Tile slot index
+        std::string             path;    //!< Path to the RDF/OBJ file
+        affine                  pose;    //!< Scaling factor for the tile
+        std::promise<mesh::ptr> promise; //!< Loaded tile promise
+      };
+
+      composite &                                 m_ground;    //!< Composite ground
+      real                                        m_horizon;   //!< Prediction time horizon (s)
+      real                                        m_margin;    //!< Bounding boxes margin (m)
+      size_t                                      m_resident;  //!< Maximum loaded tiles (residency budget)
+      metrics                                     m_metrics;   //!< Prefetching metrics
+      std::vector<std::uint32_t>                  m_tiles;     //!< Intersected tiles scratch
+      std::vector<std::pair<real, std::uint32_t>> m_evictable; //!< Evictable tiles scratch (distance, slot index)
+      std::deque<job>                             m_queue;     //!< Loading jobs queue
+      std::mutex                                  m_mutex;     //!< Loading jobs queue mutex
+      std::condition_variable                     m_wake;      //!< Loading thread wake-up condition
+      bool                                        m_stop;      //!< Loading thread stop flag
+      std::thread                                 m_worker;    //!< Background I/O thread
+
+    public:
+      //! Prefetcher copy constructor
+      prefetcher(prefetcher const &) = delete;
+
+      //! Prefetcher move constructor
+      prefetcher(prefetcher &&) = delete;
+
+      //! Prefetcher assignment operator
+      prefetcher & operator=(const prefetcher &) = delete;
+
+      //! Prefetcher move assignment operator
+      prefetcher & operator=(prefetcher &&) = delete;
+
+      //! Prefetcher class destructor (the queued tiles loading fails)
+      ~prefetcher(void);
+
+      //! Prefetcher class constructor
+      prefetcher(
+        composite & ground,                                       //!< Composite ground (must outlive the prefetcher)
+        real        horizon,                                      //!< Prediction time horizon (s)
+        real        margin   = real(0.0),                         //!< Bounding boxes margin (m)
+        size_t      resident = std::numeric_limits<size_t>::max() //!< Maximum loaded tiles (the tiles within the horizon are kept)
+      );
+
+      //! Load the tiles needed now (waiting for them if necessary) and request
+      //! the tiles expected within the horizon \n
+      //! To be called before the shell setup with the expected shell bounding box
+      void
+      update(
+        aabb const & box,     //!< Shell bounding box
+        vec3 const & velocity //!< Shell velocity (m/s)
+      );
+
+      //! Get the prefetching metrics
+      metrics const &
+      stats(void)
+      const;
+
+      //! Reset the prefetching metrics
+      void
+      reset(void);
+
+    private:
+      //! Queue the loading of the i-th tile
+      void
+      request(
+        size_t i,    //!< Tile slot index
+        bool   front //!< Queue the tile before the others
+      );
+
+      //! Unload the loaded tiles out of the horizon above the residency budget
+      void
+      evict(
+        aabb const & now,  //!< Shell bounding box with margin
+        aabb const & ahead //!< Shell bounding box swept within the horizon
+      );
+
+      //! Background I/O thread loop
+      void
+      run(void);
+
+    }; // class prefetcher
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: prefetcher.hxx
+///
@@ -36,6 +36,7 @@
 #include "mesh.hxx"
 #include "flat.hxx"
 #include "output.hxx"
+#include "statistics.hxx"
 
 namespace enve
 {
@@ -57,6 +58,9 @@ namespace enve
     real    m_y;     //!< Y-axis component  (m)
     real    m_width; //!< Width (m)
     real    m_angle; //!< Inclination angle (rad)
+#ifdef ENVE_STATISTICS
+    mutable statistics m_stats; //!< Tests, hits and fallbacks counters
+#endif
 
   public:
     //! Rib copy constructor
@@ -126,6 +130,17 @@ namespace enve
     angle(void)
     const;
 
+#ifdef ENVE_STATISTICS
+    //! Get the tests, hits and fallbacks counters
+    statistics
+    stats(void)
+    const;
+
+    //! Reset the tests, hits and fallbacks counters
+    void
+    resetStats(void);
+#endif
+
     //! Evaluate rib contact with no ground
     bool
     envelop(
@@ -142,6 +157,16 @@ namespace enve
       output                       & out     //!< Rib contact parameters output
     ) const;
 
+    //! Evaluate rib contact with a subset of ground triangles
+    bool
+    envelop(
+      triangleground::vecptr const & ground,     //!< Ground triangles list
+      triangleground::vecidx const & candidates, //!< Candidate triangles indices in the ground list
+      affine                 const & pose,       //!< Input 4x4 affine transformation pose
+      std::string            const   method,     //!< Enveloping model (choose from: "geometric" or "sampling")
+      output                       & out         //!< Rib contact parameters output
+    ) const;
+
     //! Evaluate rib contact with flat ground
     bool
     envelop(
@@ -155,9 +180,10 @@ namespace enve
     //! Evaluate rib contact with flat ground (geometric enveloping model)
     bool
     envelopGeometric(
-      triangleground::vecptr const & ground, //!< Local triangles candidate list
-      affine                 const & pose,   //!< Input 4x4 affine transformation
-      output                       & out     //!< Rib contact parameters output
+      triangleground::vecptr const & ground,     //!< Ground triangles list
+      triangleground::vecidx const & candidates, //!< Candidate triangles indices in the ground list
+      affine                 const & pose,       //!< Input 4x4 affine transformation
+      output                       & out         //!< Rib contact parameters output
     ) const;
 
     //! Evaluate rib contact with flat ground (geometric enveloping model)
@@ -171,9 +197,10 @@ namespace enve
     //! Evaluate rib contact with flat ground (sampling enveloping model)
     bool
     envelopSampling(
-      triangleground::vecptr const & ground, //!< Local triangles candidate list
-      affine                 const & pose,   //!< Input 4x4 affine transformation
-      output                       & out     //!< Rib contact parameters output
+      triangleground::vecptr const & ground,     //!< Ground triangles list
+      triangleground::vecidx const & candidates, //!< Candidate triangles indices in the ground list
+      affine                 const & pose,       //!< Input 4x4 affine transformation
+      output                       & out         //!< Rib contact parameters output
     ) const;
 
     //! Evaluate rib contact with flat ground (sampling enveloping model)
@@ -187,7 +214,8 @@ namespace enve
     //! Evaluate contact through line intersection envelop model
     bool
     samplingLine(
-      triangleground::vecptr const & ground,          //!< Local triangles candidate list
+      triangleground::vecptr const & ground,          //!< Ground triangles list
+      triangleground::vecidx const & candidates,      //!< Candidate triangles indices in the ground list
       line                   const & sampling_line,   //!< Sampling line
       point                        & contact_point,   //!< Contact point
       real                         & contact_friction //!< Contact friction
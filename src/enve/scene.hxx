@@ -0,0 +1,148 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: scene.hxx
+///
+
+#ifndef INCLUDE_ENVE_SCENE_HXX
+#define INCLUDE_ENVE_SCENE_HXX
+
+#include "mesh.hxx"
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |   ___  ___ ___ _ __   ___
+     |  / __|/ __/ _ \ '_ \ / _ \
+     |  \__ \ (_|  __/ | | |  __/
+     |  |___/\___\___|_| |_|\___|
+     |
+    \*/
+
+    //! Two-level instanced ground scene class \n
+    //! Each instance is a rigid transformation of a shared mesh, the instances
+    //! world bounding boxes are indexed by a top-level AABB tree. The memory
+    //! scales with the unique meshes and moving an instance only refits the
+    //! top-level tree nodes above it.
+    class scene
+    {
+    public:
+      //! Mesh instance data structure
+      struct instance
+      {
+        mesh::ptr ground;  //!< Shared mesh (in its own reference frame)
+        affine    pose;    //!< Mesh to scene rigid transformation
+        affine    inverse; //!< Scene to mesh rigid transformation
+      };
+
+    private:
+      std::vector<instance> m_instances; //!< Mesh instances
+      bvh                   m_AABBtree;  //!< Instances top-level AABB tree
+      bool                  m_built;     //!< Top-level tree up to date flag
+
+    public:
+      //! Scene copy constructor
+      scene(scene const &) = delete;
+
+      //! Scene move constructor
+      scene(scene &&) = delete;
+
+      //! Scene assignment operator
+      scene & operator=(const scene &) = delete;
+
+      //! Scene move assignment operator
+      scene & operator=(scene &&) = delete;
+
+      //! Scene class destructor
+      ~scene(void) = default;
+
+      //! Scene class constructor
+      scene(void);
+
+      //! Clear all the scene instances
+      void
+      clear(void);
+
+      //! Get the number of instances
+      size_t
+      size(void)
+      const;
+
+      //! Add a mesh instance (the top-level tree must be built before the queries)
+      size_t
+      add(
+        mesh::ptr const & ground,                 //!< Shared mesh
+        affine    const & pose = IDENTITY_AFFINE //!< Mesh to scene rigid transformation
+      );
+
+      //! Build the instances top-level AABB tree
+      void
+      build(void);
+
+      //! Move the i-th instance and refit the top-level AABB tree
+      void
+      move(
+        size_t         i,   //!< Instance index
+        affine const & pose //!< New mesh to scene rigid transformation
+      );
+
+      //! Get the i-th instance
+      instance const &
+      operator[](
+        size_t i //!< Instance index
+      ) const;
+
+      //! Intersect the top-level AABB tree with an external aabb object
+      bool
+      intersection(
+        aabb                       const & box,      //!< External aabb object
+        std::vector<std::uint32_t>       & instances //!< Intersected instances indices list
+      ) const;
+
+    private:
+      //! Get the i-th instance bounding box in the scene reference frame
+      aabb
+      worldBBox(
+        size_t i //!< Instance index
+      ) const;
+
+    }; // class scene
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: scene.hxx
+///
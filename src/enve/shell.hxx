@@ -32,10 +32,15 @@
 #ifndef INCLUDE_ENVE_SHELL_HXX
 #define INCLUDE_ENVE_SHELL_HXX
 
+#include "budget.hxx"
+#include "composite.hxx"
+#include "container.hxx"
 #include "flat.hxx"
 #include "mesh.hxx"
 #include "rib.hxx"
+#include "scene.hxx"
 #include "shape.hxx"
+#include "statistics.hxx"
 #include "output.hxx"
 
 namespace enve
@@ -59,7 +64,26 @@ namespace enve
     std::shared_ptr<aabb>               m_bbox;       //!< Shell bounding box (must be transformed in the mesh reference frame before intersection!)
     std::vector<rib>                    m_ribs;       //!< Shell ribs vector
     std::vector<output>                 m_out;        //!< Contact parameters output vector
-    std::vector<triangleground::vecptr> m_candidates; //!< Candidates triangle vector
+    std::vector<triangleground::vecidx> m_candidates; //!< Candidates triangle indices vector
+    triangleground::vecidx              m_local;      //!< Local intersected triangles indices
+    bool                                m_warm_start; //!< Warm-started candidates search flag
+    std::uint64_t                       m_walked;     //!< Generation of the mesh of the last local intersected triangles (0 if none)
+    std::vector<std::uint32_t>          m_visited;    //!< Open-addressing set of the triangles visited by the adjacency walk
+    size_t                              m_visits;     //!< Number of triangles visited by the last adjacency walk
+    std::vector<bool>                   m_seeded;     //!< Mesh components reached by the adjacency walk seeds
+    std::vector<real_storage>           m_ribs_y;     //!< Ribs y-axis positions scratch for candidates refinement
+    std::vector<size_t>                 m_order;      //!< Ribs evaluation order for budgeted setup (coarse to fine)
+    std::vector<bool>                   m_evaluated;  //!< Ribs evaluated flags for budgeted setup
+    ground::mesh::ptr                   m_ground;     //!< Last mesh snapshot taken from a container (keeps the walked mesh alive)
+    triangleground::vecidx              m_instances;  //!< Scene instances or composite tiles intersected by the shell
+    std::vector<output>                 m_scene_out;  //!< Contact parameters merged over the scene instances
+    triangleground::vecptr              m_gathered;   //!< Local triangles gathered from the composite tiles (or decoded)
+    std::vector<real_storage>           m_packed;     //!< Packed vertices of the gathered local triangles (relative to the shell origin)
+    std::shared_ptr<triangleground>     m_block;      //!< Reused block of the local triangles decoded from a compressed mesh
+    triangleground::vecptr              m_decoded;    //!< Pointers aliasing the decoded triangles block
+#ifdef ENVE_STATISTICS
+    statistics                          m_stats;      //!< Setup statistics (ribs counters excluded)
+#endif
 
   public:
     //! Shell copy constructor
@@ -302,6 +326,60 @@ namespace enve
      |                     |_|
     \*/
 
+    //! Enable or disable the warm-started candidates search, which walks the
+    //! mesh adjacency from the last step local triangles instead of querying
+    //! the AABB tree (the tree is still used when the walk fails)
+    void
+    warmStart(
+      bool enable //!< Warm start flag
+    );
+
+    //! Check if the warm-started candidates search is enabled
+    bool
+    warmStart(void)
+    const;
+
+    //! Get the number of triangles visited by the last adjacency walk (0 if
+    //! the AABB tree was queried instead)
+    size_t
+    walked(void)
+    const;
+
+    //! Check if the setup statistics are compiled in (ENVE_STATISTICS defined)
+    static
+    bool
+    hasStats(void);
+
+    //! Get a snapshot of the setup statistics accumulated since the last reset
+    //! (all zero unless ENVE_STATISTICS is defined)
+    statistics
+    stats(void)
+    const;
+
+    //! Reset the setup statistics
+    void
+    resetStats(void);
+
+    //! Get the shell memory footprint (the ground is not included)
+    footprint
+    memoryUsage(void)
+    const;
+
+    //! Update current shell position and find the ribs candidate triangles only
+    //! (the contact parameters are not evaluated)
+    bool
+    setupCandidates(
+      ground::mesh const & ground, //!< Mesh ground object
+      affine       const & pose,   //!< 4x4 affine transformation matrix
+      std::string  const   method  //!< Method name (choose from: "geometric" or "sampling")
+    );
+
+    //! Get the i-th rib candidate triangles indices (from the last mesh setup)
+    triangleground::vecidx const &
+    ribCandidates(
+      size_t i //!< Input index
+    ) const;
+
     //! Update current shell position and find contact parameters (intersection with mesh)
     bool
     setup(
@@ -310,6 +388,54 @@ namespace enve
       std::string  const   method  //!< Method name (choose from: "geometric" or "sampling")
     );
 
+    //! Update current shell position and find contact parameters (intersection
+    //! with mesh) within a work and time budget \n
+    //! The candidates search is charged to the budget first, then the ribs are
+    //! evaluated from coarse to fine spacing until the budget is spent,
+    //! the skipped ribs are interpolated from the evaluated ones. If no rib can
+    //! be evaluated, the last step results are moved with the shell.
+    bool
+    setup(
+      ground::mesh const & ground, //!< Mesh ground object
+      affine       const & pose,   //!< 4x4 affine transformation matrix
+      std::string  const   method, //!< Method name (choose from: "geometric" or "sampling")
+      budget       const & limits, //!< Work and time budget
+      report             & info    //!< Applied degradation report
+    );
+
+    //! Update current shell position and find contact parameters (intersection
+    //! with the instanced meshes of a scene) \n
+    //! Each rib is enveloped on every intersected instance in the instance
+    //! reference frame, the deepest contact is kept
+    bool
+    setup(
+      ground::scene const & ground, //!< Instanced ground scene
+      affine        const & pose,   //!< 4x4 affine transformation matrix
+      std::string   const   method  //!< Method name (choose from: "geometric" or "sampling")
+    );
+
+    //! Update current shell position and find contact parameters (intersection
+    //! with the tiles of a composite ground) \n
+    //! The local triangles of all the tiles under the shell are enveloped
+    //! together, so the contact is continuous across the tiles seams
+    bool
+    setup(
+      ground::composite const & ground, //!< Multi-tile composite ground
+      affine            const & pose,   //!< 4x4 affine transformation matrix
+      std::string       const   method  //!< Method name (choose from: "geometric" or "sampling")
+    );
+
+    //! Update current shell position and find contact parameters (intersection
+    //! with a compressed mesh) \n
+    //! Only the local triangles are decoded, at each setup, into a block that is
+    //! reused across the setups (it only grows)
+    bool
+    setup(
+      ground::compressed const & ground, //!< Compressed mesh ground
+      affine             const & pose,   //!< 4x4 affine transformation matrix
+      std::string        const   method  //!< Method name (choose from: "geometric" or "sampling")
+    );
+
     //! Update current shell position and find contact parameters (intersection with plane)
     bool
     setup(
@@ -318,6 +444,32 @@ namespace enve
       std::string  const   method  //!< Method name (choose from: "geometric" or "sampling")
     );
 
+    //! Update current shell position and find contact parameters (intersection
+    //! with the asynchronously loaded mesh once it is ready, with the back-up
+    //! plane until then or outside the mesh) \n
+    //! Returns true only if the contact parameters are found on the mesh
+    bool
+    setup(
+      ground::mesh::future const & ground, //!< Asynchronously loaded mesh ground
+      ground::flat         const & backup, //!< Back-up flat ground object
+      affine               const & pose,   //!< 4x4 affine transformation
+      std::string          const   method  //!< Method name (choose from: "geometric" or "sampling")
+    );
+
+    //! Update current shell position and find contact parameters (intersection
+    //! with the mesh currently published in the container, with the back-up
+    //! plane if none is published or outside the mesh) \n
+    //! The mesh snapshot is kept until the next setup, a replacement mesh is
+    //! picked up at the next setup. Returns true only if the contact parameters
+    //! are found on the mesh
+    bool
+    setup(
+      ground::container const & ground, //!< Hot-swappable mesh ground container
+      ground::flat      const & backup, //!< Back-up flat ground object
+      affine            const & pose,   //!< 4x4 affine transformation
+      std::string       const   method  //!< Method name (choose from: "geometric" or "sampling")
+    );
+
     /*\
      |                   _             _
      |    ___ ___  _ __ | |_ __ _  ___| |_
@@ -489,10 +641,57 @@ namespace enve
     ) const;
 
   private:
-    //! Update the list of ribs candidates
+    //! Find the local triangles (by adjacency walk or AABB tree query) and the ribs candidates
+    bool
+    findCandidates(
+      ground::mesh const & ground, //!< Mesh ground object
+      std::string  const   method  //!< Method name (choose from: "geometric" or "sampling")
+    );
+
+    //! Fill the i-th rib output from the evaluated ribs outputs
+    void
+    interpolateRib(
+      size_t i //!< Input index
+    );
+
+    //! Find the local triangles by walking the mesh adjacency from the last
+    //! local triangles, return false if the walk cannot be performed \n
+    //! The walk crosses the triangles whose footprint overlaps the shell bounding
+    //! box one, so that ridges are walked over, and it fails when the box reaches
+    //! a mesh component without seeds (each component footprint is assumed to be
+    //! edge-connected, as for height fields)
+    bool
+    walkIntersection(
+      ground::mesh           const & ground,      //!< Mesh ground object
+      triangleground::vecidx       & local_ground //!< Local triangles candidate indices
+    );
+
+    //! Insert the i-th triangle in the adjacency walk visited set, return false
+    //! if it was already visited
+    bool
+    visit(
+      std::uint32_t i //!< Triangle index
+    );
+
+    //! Find the contact parameters with the first gathered local triangles
+    bool
+    envelopGathered(
+      triangleground::vecptr const & triangles, //!< Gathered local triangles
+      size_t                         size,      //!< Number of gathered local triangles
+      affine                 const & pose,      //!< 4x4 affine transformation matrix
+      std::string            const   method     //!< Method name (choose from: "geometric" or "sampling")
+    );
+
+    //! Update the list of ribs candidates \n
+    //! The vertices of the t-th triangle are read through fetch(t, buffer), which
+    //! returns their 9 packed coordinates relative to the origin (either stored
+    //! by the ground or written to the 9 values buffer)
+    template <typename Fetch>
     void
     refineIntersection(
-      triangleground::vecptr const & local_ground, //!< Local triangles candidate list
+      Fetch                  const & fetch,        //!< Triangle packed vertices coordinates fetch function
+      point                  const & origin,       //!< Packed vertices coordinates origin
+      triangleground::vecidx const & local_ground, //!< Local triangles candidate indices
       bool                           refine        //!< Enable advanced ribs refinement
     );
 
@@ -0,0 +1,86 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: statistics.hxx
+///
+
+#ifndef INCLUDE_ENVE_STATISTICS_HXX
+#define INCLUDE_ENVE_STATISTICS_HXX
+
+// Hot-path instrumentation statements (compiled out unless ENVE_STATISTICS is defined)
+#ifdef ENVE_STATISTICS
+#define ENVE_STATS(...) __VA_ARGS__
+#else
+#define ENVE_STATS(...)
+#endif
+
+namespace enve
+{
+
+ /*\
+  |        _           _    _       _    _
+  |   ___ | |_   __ _ | |_ (_) ___ | |_ (_)  ___  ___
+  |  / __|| __| / _` || __|| |/ __|| __|| | / __|/ __|
+  |  \__ \| |_ | (_| || |_ | |\__ \| |_ | || (__ \__ \
+  |  |___/ \__| \__,_| \__||_||___/ \__||_| \___||___/
+  |
+ \*/
+
+  //! Shell setup statistics data class (all zero unless ENVE_STATISTICS is defined)
+  struct statistics {
+    size_t     setups       = size_t(0);       //!< Ground setups performed (each scene instance counts once)
+    size_t     queried      = size_t(0);       //!< Triangles returned by the bounding box query (or walk)
+    size_t     candidates   = size_t(0);       //!< Rib candidate triangles after the refinement
+    size_t     tests        = size_t(0);       //!< Disk/triangle (or sampling line/triangle) tests performed
+    size_t     hits         = size_t(0);       //!< Tests with an intersection
+    size_t     fallbacks    = size_t(0);       //!< Ribs with no contact (fallback to the no ground envelop)
+    acme::real time_query   = acme::real(0.0); //!< Time spent in the bounding box query or gathering (s)
+    acme::real time_refine  = acme::real(0.0); //!< Time spent in the ribs candidates refinement (s)
+    acme::real time_envelop = acme::real(0.0); //!< Time spent in the ribs enveloping (s)
+  }; // struct statistics
+
+  //! Get the seconds elapsed since a time point and restart it from now
+  inline
+  acme::real
+  lap(
+    std::chrono::steady_clock::time_point & tic //!< Time point to be restarted
+  )
+  {
+    std::chrono::steady_clock::time_point toc = std::chrono::steady_clock::now();
+    acme::real elapsed = std::chrono::duration<acme::real>(toc - tic).count();
+    tic = toc;
+    return elapsed;
+  }
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: statistics.hxx
+///
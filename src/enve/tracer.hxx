@@ -0,0 +1,169 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: tracer.hxx
+///
+
+#ifndef INCLUDE_ENVE_TRACER_HXX
+#define INCLUDE_ENVE_TRACER_HXX
+
+// Library timeline spans (compiled out unless ENVE_TRACING is defined)
+#define ENVE_TRACE_CONCAT_(A, B) A##B
+#define ENVE_TRACE_CONCAT(A, B)  ENVE_TRACE_CONCAT_(A, B)
+#ifdef ENVE_TRACING
+#define ENVE_TRACE(NAME) enve::tracer::span ENVE_TRACE_CONCAT(enve_trace_span_, __LINE__)(NAME)
+#else
+#define ENVE_TRACE(NAME)
+#endif
+
+namespace enve
+{
+
+ /*\
+  |   _
+  |  | |_  _ __   __ _   ___   ___  _ __
+  |  | __|| '__| / _` | / __| / _ \| '__|
+  |  | |_ | |   | (_| || (__ |  __/| |
+  |   \__||_|    \__,_| \___| \___||_|
+  |
+ \*/
+
+  //! Timeline tracer class \n
+  //! Records named spans in a per-thread ring buffer and exports them in the
+  //! Chrome Trace Event JSON format (readable by Perfetto and chrome://tracing).
+  //! Each thread only writes its own buffer, so recording is lock-free and the
+  //! oldest spans are overwritten when a buffer is full. Export and clear while
+  //! the traced threads are idle.
+  class tracer
+  {
+  public:
+    //! Span event data structure
+    struct event
+    {
+      char const *  name;  //!< Span name (static string)
+      std::uint64_t begin; //!< Span begin time since the tracer origin (ns)
+      std::uint64_t end;   //!< Span end time since the tracer origin (ns)
+    };
+
+    //! Scoped span class (records from construction to destruction)
+    class span
+    {
+    private:
+      char const *  m_name;  //!< Span name (nullptr if the tracer is stopped)
+      std::uint64_t m_begin; //!< Span begin time (ns)
+
+    public:
+      //! Span copy constructor
+      span(span const &) = delete;
+
+      //! Span move constructor
+      span(span &&) = delete;
+
+      //! Span assignment operator
+      span & operator=(const span &) = delete;
+
+      //! Span move assignment operator
+      span & operator=(span &&) = delete;
+
+      //! Span class constructor
+      span(
+        char const * name //!< Span name (must outlive the tracer, e.g. a string literal)
+      );
+
+      //! Span class destructor
+      ~span(void);
+
+    }; // class span
+
+    //! Check if the library spans are compiled in (ENVE_TRACING defined)
+    static
+    bool
+    hasTrace(void);
+
+    //! Start recording (new thread buffers get the given capacity)
+    static
+    void
+    start(
+      size_t capacity = 65536 //!< Events per thread buffer (rounded up to a power of two)
+    );
+
+    //! Stop recording
+    static
+    void
+    stop(void);
+
+    //! Check if the tracer is recording
+    static
+    bool
+    isEnabled(void);
+
+    //! Discard the recorded events
+    static
+    void
+    clear(void);
+
+    //! Get the number of recorded events held by the buffers
+    static
+    size_t
+    size(void);
+
+    //! Get the number of threads that recorded events
+    static
+    size_t
+    threads(void);
+
+    //! Record a span in the calling thread buffer
+    static
+    void
+    record(
+      char const *  name,  //!< Span name (static string)
+      std::uint64_t begin, //!< Span begin time (ns)
+      std::uint64_t end    //!< Span end time (ns)
+    );
+
+    //! Get the time since the tracer origin (ns)
+    static
+    std::uint64_t
+    now(void);
+
+    //! Write the recorded events in the Chrome Trace Event JSON format
+    static
+    bool
+    write(
+      std::string const & path //!< Path to the *.json file
+    );
+
+  }; // class tracer
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: tracer.hxx
+///
@@ -50,6 +50,7 @@ namespace enve
   public:
     typedef std::shared_ptr<triangleground const> ptr;    //!< Pointer to object
     typedef std::vector<triangleground::ptr>      vecptr; //!< Vector of pointers to objects
+    typedef std::vector<std::uint32_t>            vecidx; //!< Vector of 32-bit indices to objects
 
   private:
     integer m_id;       //!< ID (-)
@@ -0,0 +1,365 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: generator.cc
+///
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "enve.hh"
+
+using namespace acme;
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |                                          _
+     |    __ _   ___  _ __    ___  _ __   __ _ | |_   ___   _ __
+     |   / _` | / _ \| '_ \  / _ \| '__| / _` || __| / _ \ | '__|
+     |  | (_| ||  __/| | | ||  __/| |   | (_| || |_ | (_) || |
+     |   \__, | \___||_| |_| \___||_|    \__,_| \__| \___/ |_|
+     |   |___/
+    \*/
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    generator::generator(
+      parameters const & road
+    )
+      : m_parameters(road)
+    {
+      #define CMD "enve::generator::generator(...): "
+
+      ENVE_ASSERT(road.length > real(0.0) && road.width > real(0.0) && road.spacing > real(0.0),
+        CMD "road length, width and spacing must be positive.");
+      ENVE_ASSERT(road.roughness == 0 || (road.roughness >= 'A' && road.roughness <= 'H'),
+        CMD "roughness class must be between 'A' and 'H'.");
+
+      this->m_nx = std::max(size_t(1), size_t(std::llround(road.length / road.spacing)));
+      this->m_ny = std::max(size_t(1), size_t(std::llround(road.width / road.spacing)));
+
+      // Platform independent uniform numbers in [0,1) (std distributions are not)
+      std::mt19937 engine(road.seed);
+      auto uniform = [&engine]() {return real(engine()) / real(4294967296.0);};
+
+      // ISO 8608 tracks profiles as sums of harmonics with random phases
+      // within the standard band and below the grid Nyquist frequency
+      this->m_right.assign(this->m_nx + 1, real(0.0));
+      this->m_left.assign(this->m_nx + 1, real(0.0));
+      if (road.roughness != 0 && road.waves > 0)
+      {
+        real density = isoDensity(road.roughness);
+        real n_min   = real(0.011);
+        real n_max   = std::min(real(2.83), real(0.5) / road.spacing);
+        real n_step  = (n_max - n_min) / road.waves;
+        for (size_t k = 0; k < road.waves; ++k)
+        {
+          real n         = n_min + (k + real(0.5)) * n_step;
+          real amplitude = std::sqrt(real(2.0) * density * std::pow(n / real(0.1), real(-2.0)) * n_step);
+          real phase_r   = real(2.0) * PI * uniform();
+          real phase_l   = real(2.0) * PI * uniform();
+          for (size_t i = 0; i <= this->m_nx; ++i)
+          {
+            real x = i * road.spacing;
+            this->m_right[i] += amplitude * std::cos(real(2.0) * PI * n * x + phase_r);
+            this->m_left[i]  += amplitude * std::cos(real(2.0) * PI * n * x + phase_l);
+          }
+        }
+      }
+
+      // Potholes sorted along the road
+      for (size_t k = 0; k < road.potholes; ++k)
+      {
+        pothole hole;
+        hole.radius = road.pothole_radius * (real(0.5) + real(0.5) * uniform());
+        hole.depth  = road.pothole_depth  * (real(0.5) + real(0.5) * uniform());
+        hole.x      = hole.radius + (road.length - real(2.0) * hole.radius) * uniform();
+        hole.y      = hole.radius + (road.width  - real(2.0) * hole.radius) * uniform();
+        this->m_potholes.push_back(hole);
+      }
+      std::sort(this->m_potholes.begin(), this->m_potholes.end(),
+        [](pothole const & a, pothole const & b) {return a.x < b.x;});
+
+      // Cobblestones heights table
+      this->m_stones.resize(1024);
+      for (size_t k = 0; k < this->m_stones.size(); ++k)
+        {this->m_stones[k] = real(0.5) + real(0.5) * uniform();}
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    generator::parameters const &
+    generator::data(void)
+      const
+    {
+      return this->m_parameters;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    generator::size(void)
+      const
+    {
+      return 2 * this->m_nx * this->m_ny;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    real
+    generator::height(
+      real x,
+      real y
+    )
+      const
+    {
+      parameters const & road = this->m_parameters;
+
+      // Roughness interpolated along the road and between the tracks
+      real   s = std::min(std::max(x / road.spacing, real(0.0)), real(this->m_nx));
+      size_t i = std::min(size_t(s), this->m_nx - 1);
+      real   u = s - i;
+      real   t = std::min(std::max(y / road.width, real(0.0)), real(1.0));
+      real   z_r = (real(1.0) - u) * this->m_right[i] + u * this->m_right[i+1];
+      real   z_l = (real(1.0) - u) * this->m_left[i]  + u * this->m_left[i+1];
+      real   z   = (real(1.0) - t) * z_r + t * z_l;
+
+      // Banking around the road centreline
+      z += (y - real(0.5) * road.width) * std::tan(road.banking);
+
+      // Kerbs on both sides
+      if (road.kerb_height > real(0.0) && (y < road.kerb_width || y > road.width - road.kerb_width))
+        {z += road.kerb_height;}
+
+      // Cobblestones as domes with grooves
+      if (x >= road.cobblestone_start && x < road.cobblestone_end)
+      {
+        real   a     = x / road.cobblestone_size, b = y / road.cobblestone_size;
+        size_t stone = size_t(std::floor(a)) * 31 + size_t(std::floor(std::max(b, real(0.0)))) * 17;
+        real   dome  = std::sin(PI * a) * std::sin(PI * b);
+        z += road.cobblestone_height * this->m_stones[stone % this->m_stones.size()] * dome * dome;
+      }
+
+      // Potholes with a smooth cosine profile
+      auto first = std::lower_bound(this->m_potholes.begin(), this->m_potholes.end(), x - road.pothole_radius,
+        [](pothole const & p, real value) {return p.x < value;});
+      for (auto it = first; it != this->m_potholes.end() && it->x <= x + road.pothole_radius; ++it)
+      {
+        real r = std::hypot(x - it->x, y - it->y);
+        if (r < it->radius)
+          {z -= it->depth * real(0.5) * (real(1.0) + std::cos(PI * r / it->radius));}
+      }
+      return z;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    real
+    generator::friction(
+      real x,
+      real y
+    )
+      const
+    {
+      parameters const & road = this->m_parameters;
+      real mu = road.friction;
+      for (size_t k = 0; k < road.patches.size(); ++k)
+      {
+        patch const & p = road.patches[k];
+        if (x >= p.x_min && x < p.x_max && y >= p.y_min && y < p.y_max)
+          {mu = p.friction;}
+      }
+      return mu;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    std::vector<generator::pothole> const &
+    generator::potholes(void)
+      const
+    {
+      return this->m_potholes;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    triangleground::vecptr
+    generator::triangles(void)
+      const
+    {
+      real d = this->m_parameters.spacing;
+      triangleground::vecptr triangles;
+      triangles.reserve(this->size());
+      std::vector<point> row_0(this->m_ny + 1), row_1(this->m_ny + 1);
+      for (size_t j = 0; j <= this->m_ny; ++j)
+        {row_1[j] = this->vertex(0, j);}
+      for (size_t i = 0; i < this->m_nx; ++i)
+      {
+        row_0.swap(row_1);
+        for (size_t j = 0; j <= this->m_ny; ++j)
+          {row_1[j] = this->vertex(i + 1, j);}
+        for (size_t j = 0; j < this->m_ny; ++j)
+        {
+          real mu = this->friction((i + real(0.5)) * d, (j + real(0.5)) * d);
+          triangles.push_back(std::make_shared<triangleground const>(triangles.size(), mu, row_0[j], row_1[j], row_1[j+1]));
+          triangles.push_back(std::make_shared<triangleground const>(triangles.size(), mu, row_0[j], row_1[j+1], row_0[j+1]));
+        }
+      }
+      return triangles;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    mesh::ptr
+    generator::build(void)
+      const
+    {
+      return std::make_shared<mesh const>(this->triangles());
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    generator::write(
+      std::string const & path
+    )
+      const
+    {
+      #define CMD "enve::generator::write(...): "
+
+      std::string extension(path.size() >= 4 ? path.substr(path.size() - 4, 4) : "");
+      if (extension != ".rdf" && extension != ".obj")
+        {ENVE_ERROR(CMD "not a *.rdf or *.obj file.");}
+      bool rdf = extension == ".rdf";
+
+      std::ofstream file(path);
+      if (!file.is_open())
+        {return false;}
+      file.precision(12);
+
+      // Vertices column by column (vertex index = i*(ny+1)+j)
+      size_t ny = this->m_ny, offset = rdf ? 0 : 1;
+      point p;
+      if (rdf)
+      {
+        file
+          << "[NODES]" << std::endl
+          << "{ id  x_coord  y_coord  z_coord }" << std::endl;
+      }
+      for (size_t i = 0; i <= this->m_nx; ++i)
+      {
+        for (size_t j = 0; j <= ny; ++j)
+        {
+          p = this->vertex(i, j);
+          if (rdf)
+            {file << i * (ny + 1) + j << " " << p.x() << " " << p.y() << " " << p.z() << "\n";}
+          else
+            {file << "v " << p.x() << " " << p.y() << " " << p.z() << "\n";}
+        }
+      }
+
+      // Triangles cell by cell
+      if (rdf)
+      {
+        file
+          << "[ELEMENTS]" << std::endl
+          << "{ n1    n2    n3    mu }" << std::endl;
+      }
+      real d = this->m_parameters.spacing;
+      for (size_t i = 0; i < this->m_nx; ++i)
+      {
+        for (size_t j = 0; j < ny; ++j)
+        {
+          size_t n_0 = i * (ny + 1) + j + offset, n_1 = n_0 + ny + 1, n_2 = n_1 + 1, n_3 = n_0 + 1;
+          if (rdf)
+          {
+            real mu = this->friction((i + real(0.5)) * d, (j + real(0.5)) * d);
+            file << n_0 << " " << n_1 << " " << n_2 << " " << mu << "\n"
+                 << n_0 << " " << n_2 << " " << n_3 << " " << mu << "\n";
+          }
+          else
+          {
+            file << "f " << n_0 << " " << n_1 << " " << n_2 << "\n"
+                 << "f " << n_0 << " " << n_2 << " " << n_3 << "\n";
+          }
+        }
+      }
+      return file.good();
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    real
+    generator::isoDensity(
+      char roughness
+    )
+    {
+      #define CMD "enve::generator::isoDensity(...): "
+
+      ENVE_ASSERT(roughness >= 'A' && roughness <= 'H',
+        CMD "roughness class must be between 'A' and 'H'.");
+
+      // Geometric mean of each class, 16e-6 m^3 for class A and x4 per class
+      return real(16.0e-6) * std::pow(real(4.0), real(roughness - 'A'));
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    point
+    generator::vertex(
+      size_t i,
+      size_t j
+    )
+      const
+    {
+      real x = i * this->m_parameters.spacing;
+      real y = j * this->m_parameters.spacing;
+      return point(x, y, this->height(x, y));
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: generator.cc
+///
@@ -0,0 +1,135 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: lod.cc
+///
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "enve.hh"
+
+using namespace acme;
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |   _             _
+     |  | |  ___    __| |
+     |  | | / _ \  / _` |
+     |  | || (_) || (_| |
+     |  |_| \___/  \__,_|
+     |
+    \*/
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    lod::lod(
+      mesh::ptr         const & ground,
+      std::vector<real> const & tolerances
+    )
+    {
+      #define CMD "enve::lod::lod(...): "
+
+      ENVE_ASSERT(ground != nullptr,
+        CMD "original mesh not given.");
+
+      this->m_tolerances.push_back(real(0.0));
+      this->m_levels.push_back(ground);
+      decimator simplified(*ground);
+      for (size_t i = 0; i < tolerances.size(); ++i)
+      {
+        ENVE_ASSERT(tolerances[i] > this->m_tolerances.back(),
+          CMD "tolerances must be positive and increasing.");
+        simplified.simplify(tolerances[i]);
+        this->m_tolerances.push_back(tolerances[i]);
+        this->m_levels.push_back(std::make_shared<mesh const>(simplified.triangles()));
+      }
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    lod::size(void)
+      const
+    {
+      return this->m_levels.size();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    real
+    lod::tolerance(
+      size_t i
+    )
+      const
+    {
+      return this->m_tolerances[i];
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    mesh::ptr const &
+    lod::operator[](
+      size_t i
+    )
+      const
+    {
+      return this->m_levels[i];
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    mesh::ptr const &
+    lod::level(
+      real tolerance
+    )
+      const
+    {
+      size_t i = this->m_levels.size() - 1;
+      while (i > 0 && this->m_tolerances[i] > tolerance)
+        {--i;}
+      return this->m_levels[i];
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: lod.cc
+///
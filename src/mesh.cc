@@ -33,6 +33,10 @@
 
 #include "enve.hh"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
 namespace enve
 {
   namespace ground
@@ -47,10 +51,15 @@ namespace enve
      |
     \*/
 
+    static std::mutex s_sink_mutex; //!< Load reports sink mutex
+    static mesh::sink s_sink;       //!< Load reports sink
+
+    static std::atomic<std::uint64_t> s_generation(0); //!< Last assigned mesh generation
+
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
     mesh::mesh(void)
-      : m_AABBtree(std::make_shared<AABBtree>())
+      : m_generation(++s_generation)
     {
       this->m_triangles.reserve(100000);
     }
@@ -70,13 +79,14 @@ namespace enve
 
     mesh::mesh(
       std::string const & path,
-      affine      const & pose
+      affine      const & pose,
+      bool                morton
     )
       : mesh()
     {
       #define CMD "enve::mesh::mesh(...): "
 
-      ENVE_ASSERT(this->load(path, pose),
+      ENVE_ASSERT(this->load(path, pose, morton),
         CMD "error while reading file.");
 
       #undef CMD
@@ -87,13 +97,14 @@ namespace enve
     mesh::mesh(
       std::string const & path,
       real                friction,
-      affine      const & pose
+      affine      const & pose,
+      bool                morton
     )
       : mesh()
     {
       #define CMD "enve::mesh::mesh(...): "
 
-      ENVE_ASSERT(this->load(path, friction, pose),
+      ENVE_ASSERT(this->load(path, friction, pose, morton),
         CMD "error while reading file.");
 
       #undef CMD
@@ -101,12 +112,73 @@ namespace enve
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+    mesh::future
+    mesh::loadAsync(
+      std::string const & path,
+      affine      const & pose,
+      bool                morton
+    )
+    {
+      return std::async(std::launch::async, [path, pose, morton]() {
+        return ptr(std::make_shared<mesh const>(path, pose, morton));
+      }).share();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    mesh::future
+    mesh::loadAsync(
+      std::string const & path,
+      real                friction,
+      affine      const & pose,
+      bool                morton
+    )
+    {
+      return std::async(std::launch::async, [path, friction, pose, morton]() {
+        return ptr(std::make_shared<mesh const>(path, friction, pose, morton));
+      }).share();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    mesh::isReady(
+      future const & ground
+    )
+    {
+      return ground.valid() &&
+        ground.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    mesh::setSink(
+      sink const & function
+    )
+    {
+      std::lock_guard<std::mutex> lock(s_sink_mutex);
+      s_sink = function;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    loadreport const &
+    mesh::loadReport(void)
+      const
+    {
+      return this->m_report;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
     void
     mesh::copy(
       mesh const & mesh_obj
     )
     {
-      this->m_triangles = mesh_obj.m_triangles;
+      this->m_triangles  = mesh_obj.m_triangles;
+      this->m_generation = ++s_generation;
     }
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -120,6 +192,13 @@ namespace enve
           {this->m_triangles[i].reset();}
       }
       this->m_triangles.clear();
+      this->m_vertices.clear();
+      this->m_neighbours.clear();
+      this->m_components.clear();
+      this->m_regions.clear();
+      this->m_AABBtree.clear();
+      this->m_generation = ++s_generation;
+      this->m_report     = loadreport();
     }
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -133,6 +212,74 @@ namespace enve
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+    std::vector<real_storage> const &
+    mesh::vecVertices(void)
+      const
+    {
+      return this->m_vertices;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    point const &
+    mesh::origin(void)
+      const
+    {
+      return this->m_origin;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    std::uint32_t
+    mesh::neighbour(
+      size_t i,
+      size_t j
+    )
+      const
+    {
+      return this->m_neighbours[3*i+j];
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    std::uint32_t
+    mesh::component(
+      size_t i
+    )
+      const
+    {
+      return this->m_components[i];
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    std::vector<aabb> const &
+    mesh::components(void)
+      const
+    {
+      return this->m_regions;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    std::uint64_t
+    mesh::generation(void)
+      const
+    {
+      return this->m_generation;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bvh const &
+    mesh::AABBtree(void)
+      const
+    {
+      return this->m_AABBtree;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
     triangleground::ptr
     mesh::ptrTriangleground(
       size_t i
@@ -208,21 +355,59 @@ namespace enve
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+    footprint
+    mesh::memoryUsage(void)
+      const
+    {
+      footprint usage(this->m_AABBtree.memoryUsage());
+      size_t size = this->m_triangles.size();
+      usage.triangles = size * (sizeof(triangleground) - sizeof(aabb));
+      usage.boxes    += size * sizeof(aabb);
+      for (size_t i = 0; i < size; ++i)
+      {
+        // Triangles sharing a block (see reorder()) share its control block
+        bool shared = i > 0 && !this->m_triangles[i-1].owner_before(this->m_triangles[i]) &&
+                      !this->m_triangles[i].owner_before(this->m_triangles[i-1]);
+        usage.control += shared ? 0 : CONTROL_BLOCK_BYTES;
+      }
+      usage.pointers  = capacityBytes(this->m_triangles);
+      usage.vertices  = capacityBytes(this->m_vertices);
+      usage.adjacency = capacityBytes(this->m_neighbours) + capacityBytes(this->m_components) +
+                        capacityBytes(this->m_regions);
+      return usage;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    aabb
+    mesh::bbox(void)
+      const
+    {
+      return this->m_AABBtree.bbox();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
     bool
     mesh::load(
       std::string const & path,
-      affine      const & pose
+      affine      const & pose,
+      bool                morton
     )
     {
       #define CMD "enve::ground::load(...): "
 
+      ENVE_TRACE("mesh::load");
+
       // Start loading mesh
-      std::cout << "Loading *.rdf mesh... ";
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      this->m_report        = loadreport();
+      this->m_report.path   = path;
+      this->m_report.format = "rdf";
 
       // Check if the file is an ".rdf" file
       if (path.substr(path.size() - 4, 4) != ".rdf")
       {
-        std::cout << "Failed" << std::endl;
         ENVE_ERROR(CMD "not a *.rdf file.");
         //return false;
       }
@@ -231,7 +416,6 @@ namespace enve
       std::ifstream file(path);
       if (!file.is_open())
       {
-        std::cout << "Failed" << std::endl;
         ENVE_ERROR(CMD "*.rdf file not opened.");
         //return false;
       }
@@ -245,6 +429,10 @@ namespace enve
       bool   nodes_parse    = false;
       bool   elements_parse = false;
 
+      // Time the whole parsing once, its phases per line only with ENVE_STATISTICS
+      std::chrono::steady_clock::time_point parse = std::chrono::steady_clock::now();
+      ENVE_STATS(std::chrono::steady_clock::time_point tic = parse;)
+
       // Instantiate temporaries
       std::string curline, token;
       std::vector<std::string> s_node;
@@ -254,6 +442,9 @@ namespace enve
       real i_friction;
       while (std::getline(file, curline))
       {
+        ENVE_STATS(this->m_report.time_read += lap(tic);)
+        ++this->m_report.lines;
+        this->m_report.bytes += curline.size() + 1;
         token = this->firstToken(curline);
         if (token == "[NODES]" || token == "NODES")
         {
@@ -285,11 +476,13 @@ namespace enve
           this->split(this->tail(curline), s_node, " ");
           ENVE_ASSERT(s_node.size() == size_t(3),
             CMD "wrong numbder of elements detected.");
+          ENVE_STATS(this->m_report.time_tokenize += lap(tic);)
           p_node[0] = real(std::stod(s_node[0]));
           p_node[1] = real(std::stod(s_node[1]));
           p_node[2] = real(std::stod(s_node[2]));
           nodes.push_back(pose * p_node);
           ++nodes_count;
+          ENVE_STATS(this->m_report.time_convert += lap(tic);)
         }
         // Generate a face (vertices & indices)
         if (elements_parse)
@@ -298,6 +491,7 @@ namespace enve
           this->split(curline, s_node, " ");
           ENVE_ASSERT(s_node.size() == size_t(4),
             CMD "wrong numbder of elements detected.");
+          ENVE_STATS(this->m_report.time_tokenize += lap(tic);)
           i_element[0] = integer(std::stoi(s_node[0]));
           i_element[1] = integer(std::stoi(s_node[1]));
           i_element[2] = integer(std::stoi(s_node[2]));
@@ -310,6 +504,7 @@ namespace enve
             CMD "element 2 index cannot be negative.");
           ENVE_ASSERT(i_friction >= real(0.0),
             CMD "element friction cannot be negative.");
+          ENVE_STATS(this->m_report.time_convert += lap(tic);)
 
           // Create a shared pointer for the last triangle
           this->m_triangles.push_back(
@@ -318,11 +513,14 @@ namespace enve
               nodes[i_element[0]], nodes[i_element[1]], nodes[i_element[2]]
             ));
             ++elements_count;
+          ENVE_STATS(this->m_report.time_construct += lap(tic);)
           continue;
         }
       }
-      std::cout
-        << "Done" << std::endl;
+      ENVE_STATS(this->m_report.time_read += lap(tic);)
+      this->m_report.time_parse = lap(parse);
+      this->m_report.nodes      = nodes_count;
+      this->m_report.elements   = elements_count;
 
       // Perform safety check
       ENVE_ASSERT(nodes.size() == nodes_count && this->m_triangles.size() == elements_count,
@@ -337,12 +535,16 @@ namespace enve
       else
       {
         // Update the local intersected triangles list
-        std::cout
-          << "Building AABB tree... ";
-        this->buildAABBtree();
-        std::cout
-          << "Done" << std::endl
-          << std::endl;
+        if (morton)
+          {this->reorder();}
+        else
+          {this->buildAABBtree();}
+
+        // Complete and send the load report
+        this->m_report.time_total  = lap(start);
+        this->m_report.mesh_memory = this->memoryUsage().total();
+        this->m_report.peak_memory = peakMemory();
+        this->report();
         return true;
       }
 
@@ -355,18 +557,23 @@ namespace enve
     mesh::load(
       std::string const & path,
       real                friction,
-      affine      const & pose
+      affine      const & pose,
+      bool                morton
     )
     {
       #define CMD "enve::ground::load(...): "
 
+      ENVE_TRACE("mesh::load");
+
       // Start loading mesh
-      std::cout << "Loading *.obj mesh... ";
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      this->m_report        = loadreport();
+      this->m_report.path   = path;
+      this->m_report.format = "obj";
 
       // Check if the file is an ".obj" file
       if (path.substr(path.size() - 4, 4) != ".obj")
       {
-        std::cout << "Failed" << std::endl;
         ENVE_ERROR(CMD "not a *.obj file.");
         //return false;
       }
@@ -375,7 +582,6 @@ namespace enve
       std::ifstream file(path);
       if (!file.is_open())
       {
-        std::cout << "Failed" << std::endl;
         ENVE_ERROR(CMD "*.obj file not opened.");
         //return false;
       }
@@ -387,6 +593,10 @@ namespace enve
       size_t nodes_count    = size_t(0);
       size_t elements_count = size_t(0);
 
+      // Time the whole parsing once, its phases per line only with ENVE_STATISTICS
+      std::chrono::steady_clock::time_point parse = std::chrono::steady_clock::now();
+      ENVE_STATS(std::chrono::steady_clock::time_point tic = parse;)
+
       // Instantiate temporaries
       std::string curline, token;
       std::vector<std::string> s_node;
@@ -395,6 +605,9 @@ namespace enve
       point p_node;
       while (std::getline(file, curline))
       {
+        ENVE_STATS(this->m_report.time_read += lap(tic);)
+        ++this->m_report.lines;
+        this->m_report.bytes += curline.size() + 1;
         token = this->firstToken(curline);
         if (token == "v")
         {
@@ -402,11 +615,13 @@ namespace enve
           this->split(this->tail(curline), s_node, " ");
           ENVE_ASSERT(s_node.size() == size_t(3),
             CMD "wrong numbder of elements detected.");
+          ENVE_STATS(this->m_report.time_tokenize += lap(tic);)
           p_node[0] = std::stod(s_node[0]);
           p_node[1] = std::stod(s_node[1]);
           p_node[2] = std::stod(s_node[2]);
           nodes.push_back(pose * p_node);
           ++nodes_count;
+          ENVE_STATS(this->m_report.time_convert += lap(tic);)
           continue;
         }
         else if (token == "f")
@@ -415,6 +630,7 @@ namespace enve
           this->split(this->tail(curline), s_node, " ");
           ENVE_ASSERT(s_node.size() == size_t(3),
             CMD "wrong numbder of elements detected.");
+          ENVE_STATS(this->m_report.time_tokenize += lap(tic);)
           i_element[0] = std::stoi(s_node[0]) - 1;
           i_element[1] = std::stoi(s_node[1]) - 1;
           i_element[2] = std::stoi(s_node[2]) - 1;
@@ -424,6 +640,7 @@ namespace enve
             CMD "element 1 index cannot be negative.");
           ENVE_ASSERT(i_element[2] >= integer(0),
             CMD "element 2 index cannot be negative.");
+          ENVE_STATS(this->m_report.time_convert += lap(tic);)
 
           // Create a shared pointer for the last triangle
           this->m_triangles.push_back(
@@ -432,6 +649,7 @@ namespace enve
               nodes[i_element[0]], nodes[i_element[1]], nodes[i_element[2]]
             ));
             ++elements_count;
+          ENVE_STATS(this->m_report.time_construct += lap(tic);)
           continue;
         }
         else if (token[0] == '%' || token[0] == '#' || token[0] == '\r')
@@ -440,8 +658,10 @@ namespace enve
           continue;
         }
       }
-      std::cout
-        << "Done" << std::endl;
+      ENVE_STATS(this->m_report.time_read += lap(tic);)
+      this->m_report.time_parse = lap(parse);
+      this->m_report.nodes      = nodes_count;
+      this->m_report.elements   = elements_count;
 
       // Perform safety check
       ENVE_ASSERT(nodes.size() == nodes_count && this->m_triangles.size() == elements_count,
@@ -456,11 +676,16 @@ namespace enve
       else
       {
         // Update the local intersected triangles list
-        std::cout << "Building AABB tree... ";
-        this->buildAABBtree();
-        std::cout
-          << "Done" << std::endl
-          << std::endl;
+        if (morton)
+          {this->reorder();}
+        else
+          {this->buildAABBtree();}
+
+        // Complete and send the load report
+        this->m_report.time_total  = lap(start);
+        this->m_report.mesh_memory = this->memoryUsage().total();
+        this->m_report.peak_memory = peakMemory();
+        this->report();
         return true;
       }
 
@@ -478,18 +703,12 @@ namespace enve
     {
       #define CMD "enve::mesh::intersection(...): "
 
-      aabb::vecptr ptrVecbox{box};
-      AABBtree::ptr ptrAABBtree = std::make_shared<AABBtree>();
-      ptrAABBtree->build(ptrVecbox);
+      triangleground::vecidx indices;
+      this->intersection(box, indices);
       triangles.clear();
-      aabb::vecpairptr intersection_list;
-      this->m_AABBtree->intersection(*ptrAABBtree, intersection_list);
-      for (size_t i = 0; i < intersection_list.size(); ++i)
-      {
-        triangles.emplace_back(
-          this->ptrTriangleground((intersection_list[i].first)->id())
-          );
-      }
+      triangles.reserve(indices.size());
+      for (size_t i = 0; i < indices.size(); ++i)
+        {triangles.emplace_back(this->m_triangles[indices[i]]);}
 
       return triangles.size() > integer(0);
 
@@ -498,13 +717,62 @@ namespace enve
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+    bool
+    mesh::intersection(
+      aabb::ptr              const   box,
+      triangleground::vecidx       & triangles
+    )
+      const
+    {
+      #define CMD "enve::mesh::intersection(...): "
+
+      return this->intersection(*box, triangles);
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    mesh::intersection(
+      aabb                   const & box,
+      triangleground::vecidx       & triangles
+    )
+      const
+    {
+      #define CMD "enve::mesh::intersection(...): "
+
+      return this->m_AABBtree.intersection(box, triangles);
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
     void
     mesh::buildAABBtree(void)
     {
       #define CMD "enve::mesh::buildAABBtree(...): "
 
-      this->updateBBoxes();
-      this->m_AABBtree->build(this->m_bboxes);
+      ENVE_TRACE("mesh::buildAABBtree");
+
+      // Triangles bounding boxes packed by position
+      std::chrono::steady_clock::time_point tic = std::chrono::steady_clock::now();
+      std::vector<real> boxes;
+      boxes.reserve(6 * this->m_triangles.size());
+      for (size_t i = 0; i < this->m_triangles.size(); ++i)
+      {
+        aabb const & box = this->m_triangles[i]->bbox();
+        boxes.insert(boxes.end(), {box.min().x(), box.min().y(), box.min().z(),
+                                   box.max().x(), box.max().y(), box.max().z()});
+      }
+      this->m_report.time_boxes = lap(tic);
+      this->updateVertices();
+      this->updateNeighbours();
+      this->m_report.time_adjacency = lap(tic);
+      this->m_AABBtree.build(boxes);
+      this->m_report.time_tree = lap(tic);
+      this->m_generation       = ++s_generation;
 
       #undef CMD
     }
@@ -512,15 +780,269 @@ namespace enve
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
     void
-    mesh::updateBBoxes(void)
+    mesh::reorder(void)
     {
-      this->m_bboxes.clear();
-      for (size_t i = 0; i < this->m_triangles.size(); ++i)
+      #define CMD "enve::mesh::reorder(...): "
+
+      size_t size = this->m_triangles.size();
+      if (size == 0)
+        {return;}
+      std::chrono::steady_clock::time_point tic = std::chrono::steady_clock::now();
+
+      // Triangles centroids normalized in the mesh bounding box
+      std::vector<point> centroids(size);
+      for (size_t i = 0; i < size; ++i)
+      {
+        triangleground const & triangle = *this->m_triangles[i];
+        centroids[i] = (triangle.vertex(0) + triangle.vertex(1) + triangle.vertex(2)) / real(3.0);
+      }
+      point lower(centroids[0]), upper(centroids[0]);
+      for (size_t i = 1; i < size; ++i)
       {
-        this->m_bboxes.push_back(
-          std::make_shared<aabb const>(this->m_triangles[i]->bbox())
+        lower = lower.cwiseMin(centroids[i]);
+        upper = upper.cwiseMax(centroids[i]);
+      }
+      vec3 extent(upper - lower);
+      for (size_t j = 0; j < 3; ++j)
+        {extent[j] = extent[j] > real(0.0) ? extent[j] : real(1.0);}
+
+      // Sort the triangles by Morton code (ties keep the loading order)
+      std::vector<std::pair<std::uint64_t, std::uint32_t>> codes(size);
+      for (size_t i = 0; i < size; ++i)
+        {codes[i] = {mortonCode((centroids[i] - lower).cwiseQuotient(extent)), std::uint32_t(i)};}
+      std::sort(codes.begin(), codes.end());
+
+      // Copy the triangles in a single block in their new order (their IDs are
+      // kept), each pointer aliases the block that is freed with the last one
+      std::shared_ptr<triangleground> block(new triangleground[size], std::default_delete<triangleground[]>());
+      triangleground::vecptr sorted(size);
+      for (size_t i = 0; i < size; ++i)
+      {
+        block.get()[i].copy(*this->m_triangles[codes[i].second]);
+        sorted[i] = triangleground::ptr(block, block.get() + i);
+      }
+      this->m_triangles.swap(sorted);
+      this->m_report.time_reorder = lap(tic);
+      this->buildAABBtree();
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    mesh::update(
+      triangleground::vecidx const & indices,
+      std::vector<point>     const & vertices,
+      std::vector<real>      const & friction
+    )
+    {
+      #define CMD "enve::mesh::update(...): "
+
+      ENVE_ASSERT(vertices.size() == 3 * indices.size(),
+        CMD "vertices must be given as 3 points per updated triangle.");
+      ENVE_ASSERT(friction.size() == indices.size(),
+        CMD "friction must be given as 1 value per updated triangle.");
+
+      for (size_t k = 0; k < indices.size(); ++k)
+      {
+        size_t i = indices[k];
+        ENVE_ASSERT(i < this->m_triangles.size(),
+          CMD "triangle index out of range.");
+
+        // Replace the triangle, the old one stays valid for its current users
+        this->m_triangles[i] = std::make_shared<triangleground const>(
+          this->m_triangles[i]->id(), friction[k], vertices[3*k], vertices[3*k+1], vertices[3*k+2]
         );
+        aabb const & box    = this->m_triangles[i]->bbox();
+        aabb       & region = this->m_regions[this->m_components[i]];
+#ifdef ENVE_SINGLE_PRECISION
+        this->updateVertices(i);
+#endif
+        this->m_AABBtree.update(i, box);
+        region.min() = region.min().cwiseMin(box.min());
+        region.max() = region.max().cwiseMax(box.max());
+      }
+      this->m_AABBtree.refit();
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    mesh::updateVertices(
+      size_t i
+    )
+    {
+      real_storage * packed = &this->m_vertices[9 * i];
+      for (size_t j = 0; j < 3; ++j)
+      {
+        vec3 vertex(this->m_triangles[i]->vertex(j) - this->m_origin);
+        packed[3*j]   = real_storage(vertex.x());
+        packed[3*j+1] = real_storage(vertex.y());
+        packed[3*j+2] = real_storage(vertex.z());
+      }
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    mesh::updateVertices(void)
+    {
+      // Center the packed coordinates on the mesh bounding box
+      point lower(this->m_triangles.empty() ? point(0.0, 0.0, 0.0) : this->m_triangles[0]->vertex(0)), upper(lower);
+      for (size_t i = 0; i < this->m_triangles.size(); ++i)
+      {
+        for (size_t j = 0; j < 3; ++j)
+        {
+          lower = lower.cwiseMin(this->m_triangles[i]->vertex(j));
+          upper = upper.cwiseMax(this->m_triangles[i]->vertex(j));
+        }
+      }
+      this->m_origin = (lower + upper) / real(2.0);
+
+      // The single precision copy of the vertices is the only one read by the
+      // candidates prefilter, double precision builds read the triangles
+#ifdef ENVE_SINGLE_PRECISION
+      this->m_vertices.resize(9 * this->m_triangles.size());
+      for (size_t i = 0; i < this->m_triangles.size(); ++i)
+        {this->updateVertices(i);}
+#endif
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    mesh::updateNeighbours(void)
+    {
+      // Edge identified by its sorted vertices coordinates
+      struct edge
+      {
+        std::array<real, 6> key;      // Sorted vertices coordinates
+        std::uint32_t       triangle; // Triangle index
+        std::uint32_t       slot;     // Edge index in the triangle
+      };
+
+      size_t size = this->m_triangles.size();
+      std::vector<edge> edges(3 * size);
+      for (size_t i = 0; i < size; ++i)
+      {
+        for (size_t j = 0; j < 3; ++j)
+        {
+          point const & v_a = this->m_triangles[i]->vertex(j);
+          point const & v_b = this->m_triangles[i]->vertex((j+1) % 3);
+          bool swap = std::lexicographical_compare(v_b.data(), v_b.data() + 3, v_a.data(), v_a.data() + 3);
+          point const & v_0 = swap ? v_b : v_a;
+          point const & v_1 = swap ? v_a : v_b;
+          edge & e = edges[3*i+j];
+          e.key      = {v_0.x(), v_0.y(), v_0.z(), v_1.x(), v_1.y(), v_1.z()};
+          e.triangle = std::uint32_t(i);
+          e.slot     = std::uint32_t(j);
+        }
+      }
+      std::sort(edges.begin(), edges.end(),
+        [](edge const & e_a, edge const & e_b) {return e_a.key < e_b.key;});
+
+      // Link the triangles sharing an edge (non-manifold edges link the first pair)
+      this->m_neighbours.assign(3 * size, NONE_INDEX);
+      for (size_t k = 0; k + 1 < edges.size(); ++k)
+      {
+        edge const & e_a = edges[k];
+        edge const & e_b = edges[k+1];
+        if (e_a.key == e_b.key && e_a.triangle != e_b.triangle)
+        {
+          this->m_neighbours[3*e_a.triangle+e_a.slot] = e_b.triangle;
+          this->m_neighbours[3*e_b.triangle+e_b.slot] = e_a.triangle;
+          ++k;
+        }
+      }
+
+      // Label the edge-connected components and collect their bounding boxes
+      this->m_components.assign(size, NONE_INDEX);
+      this->m_regions.clear();
+      std::vector<std::uint32_t> stack;
+      for (size_t i = 0; i < size; ++i)
+      {
+        if (this->m_components[i] != NONE_INDEX)
+          {continue;}
+        std::uint32_t c = std::uint32_t(this->m_regions.size());
+        this->m_regions.push_back(this->m_triangles[i]->bbox());
+        aabb & region = this->m_regions.back();
+        this->m_components[i] = c;
+        stack.assign(1, std::uint32_t(i));
+        while (!stack.empty())
+        {
+          std::uint32_t t = stack.back();
+          stack.pop_back();
+          aabb const & box = this->m_triangles[t]->bbox();
+          region.min() = region.min().cwiseMin(box.min());
+          region.max() = region.max().cwiseMax(box.max());
+          for (size_t j = 0; j < 3; ++j)
+          {
+            std::uint32_t n = this->m_neighbours[3*t+j];
+            if (n != NONE_INDEX && this->m_components[n] == NONE_INDEX)
+            {
+              this->m_components[n] = c;
+              stack.push_back(n);
+            }
+          }
+        }
+      }
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    mesh::peakMemory(void)
+    {
+#if defined(__APPLE__)
+      struct rusage usage;
+      return getrusage(RUSAGE_SELF, &usage) == 0 ? size_t(usage.ru_maxrss) : size_t(0);
+#elif defined(__unix__)
+      struct rusage usage;
+      return getrusage(RUSAGE_SELF, &usage) == 0 ? size_t(usage.ru_maxrss) * size_t(1024) : size_t(0);
+#else
+      return size_t(0);
+#endif
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    mesh::report(void)
+      const
+    {
+      sink function;
+      {
+        std::lock_guard<std::mutex> lock(s_sink_mutex);
+        function = s_sink;
+      }
+      if (function)
+        {function(this->m_report);}
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    std::uint64_t
+    mesh::mortonCode(
+      vec3 const & unit
+    )
+    {
+      // Quantize each coordinate to 21 bits and spread them every 3 bits
+      std::uint64_t code = 0;
+      for (size_t j = 0; j < 3; ++j)
+      {
+        real          clamped = std::min(std::max(unit[j], real(0.0)), real(1.0));
+        std::uint64_t bits    = std::uint64_t(clamped * real(0x1FFFFF));
+        bits = (bits | bits << 32) & 0x1F00000000FFFFULL;
+        bits = (bits | bits << 16) & 0x1F0000FF0000FFULL;
+        bits = (bits | bits << 8)  & 0x100F00F00F00F00FULL;
+        bits = (bits | bits << 4)  & 0x10C30C30C30C30C3ULL;
+        bits = (bits | bits << 2)  & 0x1249249249249249ULL;
+        code |= bits << j;
       }
+      return code;
     }
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -0,0 +1,263 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: prefetcher.cc
+///
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "enve.hh"
+
+using namespace acme;
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |                   __      _       _
+     |   _ __  _ __ ___ / _| ___| |_ ___| |__   ___ _ __
+     |  | '_ \| '__/ _ \ |_ / _ \ __/ __| '_ \ / _ \ '__|
+     |  | |_) | | |  __/  _|  __/ || (__| | | |  __/ |
+     |  | .__/|_|  \___|_|  \___|\__\___|_| |_|\___|_|
+     |  |_|
+    \*/
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    prefetcher::~prefetcher(void)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_stop = true;
+      }
+      this->m_wake.notify_one();
+      this->m_worker.join();
+
+      // Fail the queued tiles instead of loading them
+      for (size_t k = 0; k < this->m_queue.size(); ++k)
+      {
+        job & tile = this->m_queue[k];
+        tile.promise.set_exception(std::make_exception_ptr(
+          std::runtime_error("enve::prefetcher::~prefetcher(...): stopped before loading the tile.")));
+        this->m_ground.unload(tile.index);
+      }
+      this->m_queue.clear();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    prefetcher::prefetcher(
+      composite & ground,
+      real        horizon,
+      real        margin,
+      size_t      resident
+    )
+      : m_ground(ground),
+        m_horizon(horizon),
+        m_margin(margin),
+        m_resident(resident),
+        m_stop(false)
+    {
+      this->m_worker = std::thread(&prefetcher::run, this);
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    prefetcher::update(
+      aabb const & box,
+      vec3 const & velocity
+    )
+    {
+      // Index the tiles loaded in the meantime
+      this->m_ground.update();
+
+      // Tiles needed now
+      vec3 margin(this->m_margin, this->m_margin, this->m_margin);
+      aabb now(box.min() - margin, box.max() + margin);
+      this->m_ground.intersection(now, this->m_tiles);
+      for (size_t k = 0; k < this->m_tiles.size(); ++k)
+      {
+        size_t i = this->m_tiles[k];
+        if (this->m_ground.isLoaded(i))
+        {
+          ++this->m_metrics.hits;
+          continue;
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        this->request(i, true);
+        this->m_ground.wait(i);
+        this->m_metrics.stall_time += std::chrono::duration<real>(std::chrono::steady_clock::now() - start).count();
+        ++this->m_metrics.stalls;
+      }
+
+      // Tiles expected within the horizon
+      vec3 shift(velocity * this->m_horizon);
+      aabb ahead(now.min().cwiseMin(now.min() + shift), now.max().cwiseMax(now.max() + shift));
+      this->m_ground.intersection(ahead, this->m_tiles);
+      for (size_t k = 0; k < this->m_tiles.size(); ++k)
+      {
+        size_t i = this->m_tiles[k];
+        if (!this->m_ground.isLoaded(i) && !this->m_ground.isLoading(i))
+        {
+          this->request(i, false);
+          ++this->m_metrics.requests;
+        }
+      }
+
+      // Tiles no longer needed
+      this->evict(now, ahead);
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    prefetcher::metrics const &
+    prefetcher::stats(void)
+      const
+    {
+      return this->m_metrics;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    prefetcher::reset(void)
+    {
+      this->m_metrics = metrics();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    prefetcher::request(
+      size_t i,
+      bool   front
+    )
+    {
+      std::lock_guard<std::mutex> lock(this->m_mutex);
+      if (this->m_ground.isLoading(i))
+      {
+        // Already queued, move it before the others if needed now
+        if (front)
+        {
+          for (auto it = this->m_queue.begin(); it != this->m_queue.end(); ++it)
+          {
+            if (it->index == i)
+            {
+              job moved(std::move(*it));
+              this->m_queue.erase(it);
+              this->m_queue.push_front(std::move(moved));
+              break;
+            }
+          }
+        }
+        return;
+      }
+
+      job tile;
+      tile.index = i;
+      tile.path = this->m_ground.tileSource(i).path;
+      tile.pose = this->m_ground.tileSource(i).pose;
+      this->m_ground.load(i, tile.promise.get_future().share());
+      if (front)
+        {this->m_queue.push_front(std::move(tile));}
+      else
+        {this->m_queue.push_back(std::move(tile));}
+      this->m_wake.notify_one();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    prefetcher::evict(
+      aabb const & now,
+      aabb const & ahead
+    )
+    {
+      // Loaded tiles out of the horizon (in-memory tiles cannot be loaded again)
+      size_t loaded = 0;
+      point  center((now.min() + now.max()) / real(2.0));
+      this->m_evictable.clear();
+      for (size_t i = 0; i < this->m_ground.size(); ++i)
+      {
+        if (!this->m_ground.isLoaded(i))
+          {continue;}
+        ++loaded;
+        mesh::ptr tile(this->m_ground[i]);
+        if (!this->m_ground.tileSource(i).path.empty() && !tile->bbox().intersects(ahead))
+          {this->m_evictable.emplace_back(tile->bbox().centerDistance(center), std::uint32_t(i));}
+      }
+      if (loaded <= this->m_resident)
+        {return;}
+
+      // Unload the farthest tiles first
+      std::sort(this->m_evictable.begin(), this->m_evictable.end(),
+        [](std::pair<real, std::uint32_t> const & a, std::pair<real, std::uint32_t> const & b) {return a.first > b.first;});
+      for (size_t k = 0; k < this->m_evictable.size() && loaded > this->m_resident; ++k, --loaded)
+      {
+        this->m_ground.unload(this->m_evictable[k].second);
+        ++this->m_metrics.evictions;
+      }
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    prefetcher::run(void)
+    {
+      std::unique_lock<std::mutex> lock(this->m_mutex);
+      while (true)
+      {
+        this->m_wake.wait(lock, [this]() {return this->m_stop || !this->m_queue.empty();});
+        if (this->m_stop)
+          {break;}
+        job tile(std::move(this->m_queue.front()));
+        this->m_queue.pop_front();
+        lock.unlock();
+        try
+          {tile.promise.set_value(composite::loadTile(tile.path, tile.pose));}
+        catch (...)
+          {tile.promise.set_exception(std::current_exception());}
+        lock.lock();
+      }
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: prefetcher.cc
+///
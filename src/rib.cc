@@ -140,9 +140,46 @@ namespace enve
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#ifdef ENVE_STATISTICS
+  statistics
+  rib::stats(void)
+    const
+  {
+    return this->m_stats;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  rib::resetStats(void)
+  {
+    this->m_stats = statistics();
+  }
+#endif
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  rib::envelop(
+    triangleground::vecptr const & ground,
+    affine                 const & pose,
+    std::string            const   method,
+    output                       & out
+  )
+    const
+  {
+    triangleground::vecidx candidates(ground.size());
+    for (size_t i = 0; i < ground.size(); ++i)
+      {candidates[i] = std::uint32_t(i);}
+    return this->envelop(ground, candidates, pose, method, out);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   bool
   rib::envelop(
     triangleground::vecptr const & ground,
+    triangleground::vecidx const & candidates,
     affine                 const & pose,
     std::string            const   method,
     output                       & out
@@ -151,10 +188,11 @@ namespace enve
   {
     #define CMD "enve::rib::envelop(...): "
 
+    ENVE_TRACE("rib::envelop");
     if (method == "geometric")
-      {return this->envelopGeometric(ground, pose, out);}
+      {return this->envelopGeometric(ground, candidates, pose, out);}
     else if (method == "sampling")
-      {return this->envelopSampling(ground, pose, out);}
+      {return this->envelopSampling(ground, candidates, pose, out);}
     else
       {ENVE_ERROR(CMD "invalid enveloping method.");}
 
@@ -193,6 +231,7 @@ namespace enve
   )
     const
   {
+    ENVE_STATS(++this->m_stats.fallbacks;)
     out.point    = pose.translation() + pose.linear() *
                    (this->center() - this->radius() * UNITZ_VEC3);
     out.normal   = pose.linear() * UNITZ_VEC3;
@@ -208,6 +247,7 @@ namespace enve
   bool
   rib::envelopGeometric(
     triangleground::vecptr const & ground,
+    triangleground::vecidx const & candidates,
     affine                 const & pose,
     output                       & out
   )
@@ -246,11 +286,14 @@ namespace enve
     bool int_bool = false;
     segment segment_tmp;
     disk  rib_grd(radius, center_grd, normal_grd);
-    for (size_t i = 0; i < ground.size(); ++i)
+    for (size_t i = 0; i < candidates.size(); ++i)
     {
       // Perform rib/triangleground intersection
-      if (Intersection(*ground[i], rib_grd, segment_tmp, EPSILON_ENVE)) // FIXME: tolerance should be scaled
+      triangleground const & triangle_i = *ground[candidates[i]];
+      ENVE_STATS(++this->m_stats.tests;)
+      if (Intersection(triangle_i, rib_grd, segment_tmp, EPSILON_ENVE)) // FIXME: tolerance should be scaled
       {
+        ENVE_STATS(++this->m_stats.hits;)
         // Find intersection points
         p_a = rotation_inv * (segment_tmp.vertex(0) - center_grd);
         p_b = rotation_inv * (segment_tmp.vertex(1) - center_grd);
@@ -292,8 +335,8 @@ namespace enve
         segment_volume_tmp   = section_area * width;
         contact_point_tmp    = origin + rotation * (center + r_c * point(cos_t_c, real(0.0), sin_t_c));
         normal_tmp           = rotation * vec3(-cos_t_c, real(0.0), -sin_t_c);
-        contact_normal_tmp   = (normal_tmp + normal_grd * (ground[i]->normal() - normal_tmp).dot(normal_grd)).normalized();
-        contact_friction_tmp = ground[i]->friction();
+        contact_normal_tmp   = (normal_tmp + normal_grd * (triangle_i.normal() - normal_tmp).dot(normal_grd)).normalized();
+        contact_friction_tmp = triangle_i.friction();
 
         // Store total results
         segment_area_tot     += segment_area_tmp;
@@ -349,6 +392,7 @@ namespace enve
     segment segment_tmp;
     disk rib_grd(radius, center_grd, normal_grd);
     bool int_bool = Intersection(ground, rib_grd, segment_tmp, EPSILON_ENVE);
+    ENVE_STATS(++this->m_stats.tests; this->m_stats.hits += int_bool;)
 
     // Compute remaining contact parameters
     if (int_bool && segment_tmp.length() > EPSILON_ENVE)
@@ -376,6 +420,7 @@ namespace enve
   bool
   rib::envelopSampling(
     triangleground::vecptr const & ground,
+    triangleground::vecidx const & candidates,
     affine                 const & pose,
     output                       & out
   )
@@ -395,9 +440,9 @@ namespace enve
     // Store temporaries
     real delta_x = real(0.1) * radius;
     real delta_y = real(0.3) * width;
-    std::vector<line>  line_vec(4);
-    std::vector<point> point_vec(4);
-    std::vector<real>  friction_vec(4);
+    line  line_vec[4];
+    point point_vec[4];
+    real  friction_vec[4] = {};
 
     // Build sampling lines
     line_vec[0] = line(origin + rotation * (center + delta_x * UNITX_VEC3), -UNITZ_VEC3);
@@ -407,10 +452,10 @@ namespace enve
 
     // Sample flat ground
     bool sampling = true;
-    sampling = sampling && this->samplingLine(ground, line_vec[0], point_vec[0], friction_vec[0]);
-    sampling = sampling && this->samplingLine(ground, line_vec[1], point_vec[1], friction_vec[1]);
-    sampling = sampling && this->samplingLine(ground, line_vec[2], point_vec[2], friction_vec[2]);
-    sampling = sampling && this->samplingLine(ground, line_vec[3], point_vec[3], friction_vec[3]);
+    sampling = sampling && this->samplingLine(ground, candidates, line_vec[0], point_vec[0], friction_vec[0]);
+    sampling = sampling && this->samplingLine(ground, candidates, line_vec[1], point_vec[1], friction_vec[1]);
+    sampling = sampling && this->samplingLine(ground, candidates, line_vec[2], point_vec[2], friction_vec[2]);
+    sampling = sampling && this->samplingLine(ground, candidates, line_vec[3], point_vec[3], friction_vec[3]);
 
     // Compute output point and normal
     out.point  = (point_vec[0] + point_vec[1] + point_vec[2] + point_vec[3]) / real(4.0);
@@ -465,9 +510,9 @@ namespace enve
     // Store temporaries
     real delta_x = real(0.1) * radius;
     real delta_y = real(0.3) * width;
-    std::vector<line>  line_vec(4);
-    std::vector<point> point_vec(4);
-    std::vector<real>  friction_vec(4);
+    line  line_vec[4];
+    point point_vec[4];
+    real  friction_vec[4] = {};
 
     // Build sampling lines
     line_vec[0] = line(origin + rotation * (center + delta_x * UNITX_VEC3), -UNITZ_VEC3);
@@ -516,68 +561,32 @@ namespace enve
   bool
   rib::samplingLine(
     triangleground::vecptr const & ground,
+    triangleground::vecidx const & candidates,
     line                   const & sampling_line,
     point                        & contact_point,
     real                         & contact_friction
   )
     const
   {
-    #define CMD "enve::rib::samplingLine(...): "
-
-    size_t             ground_size = ground.size();
-    point              point_tmp;
-    std::vector<point> point_vec;
-    std::vector<real>  friction_vec;
-    point_vec.reserve(ground_size);
-    friction_vec.reserve(ground_size);
-    bool int_bool = false;
-    for (size_t i = 0; i < ground_size; ++i)
+    // Select the highest intersection point (false if flying over or out of mesh)
+    point point_tmp;
+    bool  int_bool = false;
+    for (size_t i = 0; i < candidates.size(); ++i)
     {
-      if (Intersection(sampling_line, *ground[i], point_tmp, EPSILON_ENVE))
+      triangleground const & triangle_i = *ground[candidates[i]];
+      ENVE_STATS(++this->m_stats.tests;)
+      if (Intersection(sampling_line, triangle_i, point_tmp, EPSILON_ENVE))
       {
-        point_vec.push_back(point_tmp);
-        friction_vec.push_back(ground[i]->friction());
-        int_bool = true;
-      }
-    }
-    // Select the highest intersection point
-    if (point_vec.size() == 1 && int_bool)
-    {
-      contact_point    = point_vec[0];
-      contact_friction = friction_vec[0];
-      return true;
-    }
-    else if (point_vec.size() > 1 && int_bool)
-    {
-      contact_point    = point_vec[0];
-      contact_friction = friction_vec[0];
-      for (size_t j = 1; j < point_vec.size(); ++j)
-      {
-        if (point_vec[j].z() > contact_point.z())
+        ENVE_STATS(++this->m_stats.hits;)
+        if (!int_bool || point_tmp.z() > contact_point.z())
         {
-          contact_point    = point_vec[j];
-          contact_friction = friction_vec[j];
+          contact_point    = point_tmp;
+          contact_friction = triangle_i.friction();
+          int_bool         = true;
         }
       }
-      return true;
     }
-    else if (ground_size > 0 && !int_bool)
-    {
-      // Flying over the mesh
-      return false;
-    }
-    else if (ground_size == 0)
-    {
-      // Out of mesh
-      return false;
-    }
-    else
-    {
-      ENVE_ERROR(CMD "condition not handled.");
-      //return false;
-    }
-
-    #undef CMD
+    return int_bool;
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -591,8 +600,10 @@ namespace enve
   )
     const
   {
+    ENVE_STATS(++this->m_stats.tests;)
     if (Intersection(sampling_line, ground, contact_point, EPSILON_ENVE))
     {
+      ENVE_STATS(++this->m_stats.hits;)
       contact_friction = ground.friction();
       return true;
     }
@@ -0,0 +1,208 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: scene.cc
+///
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "enve.hh"
+
+using namespace acme;
+
+namespace enve
+{
+
+  namespace ground
+  {
+
+    /*\
+     |   ___  ___ ___ _ __   ___
+     |  / __|/ __/ _ \ '_ \ / _ \
+     |  \__ \ (_|  __/ | | |  __/
+     |  |___/\___\___|_| |_|\___|
+     |
+    \*/
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    scene::scene(void)
+      : m_built(true)
+    {
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    scene::clear(void)
+    {
+      this->m_instances.clear();
+      this->m_AABBtree.clear();
+      this->m_built = true;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    scene::size(void)
+      const
+    {
+      return this->m_instances.size();
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    size_t
+    scene::add(
+      mesh::ptr const & ground,
+      affine    const & pose
+    )
+    {
+      #define CMD "enve::scene::add(...): "
+
+      ENVE_ASSERT(ground && ground->size() > 0,
+        CMD "empty mesh instance.");
+
+      instance object;
+      object.ground  = ground;
+      object.pose    = pose;
+      object.inverse = pose.inverse();
+      this->m_instances.push_back(object);
+      this->m_built = false;
+      return this->m_instances.size() - 1;
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    scene::build(void)
+    {
+      std::vector<real> boxes;
+      boxes.reserve(6 * this->m_instances.size());
+      for (size_t i = 0; i < this->m_instances.size(); ++i)
+      {
+        aabb box(this->worldBBox(i));
+        boxes.insert(boxes.end(), {box.min().x(), box.min().y(), box.min().z(),
+                                   box.max().x(), box.max().y(), box.max().z()});
+      }
+      this->m_AABBtree.build(boxes, 1);
+      this->m_built = true;
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    void
+    scene::move(
+      size_t         i,
+      affine const & pose
+    )
+    {
+      #define CMD "enve::scene::move(...): "
+
+      ENVE_ASSERT(i < this->m_instances.size(),
+        CMD "instance index out of range.");
+
+      this->m_instances[i].pose    = pose;
+      this->m_instances[i].inverse = pose.inverse();
+      if (this->m_built)
+      {
+        this->m_AABBtree.update(i, this->worldBBox(i));
+        this->m_AABBtree.refit();
+      }
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    scene::instance const &
+    scene::operator[](
+      size_t i
+    )
+      const
+    {
+      return this->m_instances[i];
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    bool
+    scene::intersection(
+      aabb                       const & box,
+      std::vector<std::uint32_t>       & instances
+    )
+      const
+    {
+      #define CMD "enve::scene::intersection(...): "
+
+      ENVE_ASSERT(this->m_built,
+        CMD "top-level tree not built, call build() after adding instances.");
+      return this->m_AABBtree.intersection(box, instances);
+
+      #undef CMD
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    aabb
+    scene::worldBBox(
+      size_t i
+    )
+      const
+    {
+      // Bound the transformed corners of the mesh bounding box
+      instance const & object = this->m_instances[i];
+      aabb  box(object.ground->bbox());
+      point p_min(INFTY, INFTY, INFTY), p_max(-INFTY, -INFTY, -INFTY), corner;
+      for (size_t k = 0; k < 8; ++k)
+      {
+        corner = point(
+          (k & 1) ? box.max().x() : box.min().x(),
+          (k & 2) ? box.max().y() : box.min().y(),
+          (k & 4) ? box.max().z() : box.min().z()
+        );
+        corner = object.pose * corner;
+        p_min  = p_min.cwiseMin(corner);
+        p_max  = p_max.cwiseMax(corner);
+      }
+      return aabb(p_min, p_max);
+    }
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  } // namespace ground
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: scene.cc
+///
@@ -58,7 +58,10 @@ namespace enve
     real   Ly
   )
     : m_shape(std::make_shared<shape>(Rx, Mx, Ry, My, Ly)),
-      m_bbox(std::make_shared<aabb>())
+      m_bbox(std::make_shared<aabb>()),
+      m_warm_start(false),
+      m_walked(0),
+      m_visits(0)
   {
     this->m_affine.matrix() = IDENTITY_MAT4;
     this->resize(size);
@@ -77,6 +80,14 @@ namespace enve
     ENVE_ASSERT(size > size_t(0),
       CMD "negative ribs number detected.");
 
+    // Keep the counters of the removed ribs
+    ENVE_STATS(
+      statistics ribs(this->stats());
+      this->m_stats.tests     = ribs.tests;
+      this->m_stats.hits      = ribs.hits;
+      this->m_stats.fallbacks = ribs.fallbacks;
+    )
+
     // Resize the contact point, friction and normal vectors
     for (size_t i = 0; i < this->m_candidates.size(); ++i)
       {this->m_candidates[i].clear();}
@@ -87,6 +98,28 @@ namespace enve
     this->m_candidates.resize(size);
     for (size_t i = 0; i < size; ++i)
       {this->m_candidates[i].reserve(200);}
+    this->m_ribs_y.resize(size);
+    this->m_out.resize(size);
+    this->m_scene_out.resize(size);
+
+    // Ribs evaluation order for budgeted setup: central rib first, then halving spacing
+    size_t stride = 1;
+    while (stride < size)
+      {stride *= 2;}
+    this->m_order.clear();
+    this->m_evaluated.assign(size, false);
+    for (; stride > 0; stride /= 2)
+    {
+      for (size_t i = (size / 2) % stride; i < size; i += stride)
+      {
+        if (!this->m_evaluated[i])
+        {
+          this->m_evaluated[i] = true;
+          this->m_order.push_back(i);
+        }
+      }
+    }
+    this->m_evaluated.assign(size, false);
 
     // Locate the disks
     real shellWidth = this->m_shape->surfaceWidth();
@@ -437,6 +470,131 @@ namespace enve
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  shell::warmStart(
+    bool enable
+  )
+  {
+    this->m_warm_start = enable;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  shell::warmStart(void)
+    const
+  {
+    return this->m_warm_start;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  size_t
+  shell::walked(void)
+    const
+  {
+    return this->m_visits;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  shell::hasStats(void)
+  {
+#ifdef ENVE_STATISTICS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  statistics
+  shell::stats(void)
+    const
+  {
+#ifdef ENVE_STATISTICS
+    statistics snapshot(this->m_stats);
+    for (size_t i = 0; i < this->m_ribs.size(); ++i)
+    {
+      statistics ribs(this->m_ribs[i].stats());
+      snapshot.tests     += ribs.tests;
+      snapshot.hits      += ribs.hits;
+      snapshot.fallbacks += ribs.fallbacks;
+    }
+    return snapshot;
+#else
+    return statistics();
+#endif
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  shell::resetStats(void)
+  {
+#ifdef ENVE_STATISTICS
+    this->m_stats = statistics();
+    for (size_t i = 0; i < this->m_ribs.size(); ++i)
+      {this->m_ribs[i].resetStats();}
+#endif
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  footprint
+  shell::memoryUsage(void)
+    const
+  {
+    footprint usage;
+    usage.candidates = capacityBytes(this->m_candidates) + capacityBytes(this->m_local) + capacityBytes(this->m_ribs_y);
+    for (size_t i = 0; i < this->m_candidates.size(); ++i)
+      {usage.candidates += capacityBytes(this->m_candidates[i]);}
+    usage.triangles = this->m_decoded.size() * (sizeof(triangleground) - sizeof(aabb));
+    usage.boxes     = this->m_decoded.size() * sizeof(aabb);
+    usage.control   = this->m_block ? CONTROL_BLOCK_BYTES : size_t(0);
+    usage.pointers  = capacityBytes(this->m_gathered) + capacityBytes(this->m_decoded);
+    usage.vertices  = capacityBytes(this->m_packed);
+    usage.other     = sizeof(shell) + sizeof(shape) + sizeof(aabb) + 2 * CONTROL_BLOCK_BYTES +
+                      capacityBytes(this->m_ribs) + capacityBytes(this->m_out) + capacityBytes(this->m_scene_out) +
+                      capacityBytes(this->m_visited) + capacityBytes(this->m_order) + capacityBytes(this->m_instances) +
+                      (this->m_evaluated.capacity() + this->m_seeded.capacity()) / 8;
+    return usage;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  shell::setupCandidates(
+    ground::mesh const & ground,
+    affine       const & pose,
+    std::string  const   method
+  )
+  {
+    #define CMD "enve::shell::setupCandidates(...): "
+
+    // Set the new reference frame
+    this->transform(pose);
+    this->updateBBox();
+    return this->findCandidates(ground, method);
+
+    #undef CMD
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  triangleground::vecidx const &
+  shell::ribCandidates(
+    size_t i
+  )
+    const
+  {
+    return this->m_candidates[i];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   bool
   shell::setup(
     ground::mesh const & ground,
@@ -446,17 +604,14 @@ namespace enve
   {
     #define CMD "enve::shell::setup(...): "
 
+    ENVE_TRACE("shell::setup");
+
     // Set the new reference frame
     this->transform(pose);
     this->updateBBox();
 
-    // Local intersected triangles vector
-    triangleground::vecptr local_ground;
-    local_ground.reserve(200);
-    ground.intersection(this->m_bbox, local_ground);
-
     // End setup if there are no intersections
-    if (local_ground.size() < size_t(1))
+    if (!this->findCandidates(ground, method))
     {
       for (size_t i = 0; i < this->size(); ++i)
         {this->m_ribs[i].envelop(pose, this->m_out[i]);}
@@ -464,13 +619,13 @@ namespace enve
     }
     else
     {
-      // Calculate ribs candidates to speed up calculations
-      this->refineIntersection(local_ground, method == "geometric" && local_ground.size() > integer(3));
-
       // Perform intersection on all ribs
+      ENVE_STATS(std::chrono::steady_clock::time_point tic = std::chrono::steady_clock::now();)
+      triangleground::vecptr const & triangles = ground.vecptrTriangleground();
       bool out = false;
       for (size_t i = 0; i < this->size(); ++i)
-        {out = this->m_ribs[i].envelop(this->m_candidates[i], pose, method, this->m_out[i]) || out;}
+        {out = this->m_ribs[i].envelop(triangles, this->m_candidates[i], pose, method, this->m_out[i]) || out;}
+      ENVE_STATS(this->m_stats.time_envelop += lap(tic);)
       return out;
     }
 
@@ -479,6 +634,283 @@ namespace enve
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  bool
+  shell::setup(
+    ground::mesh const & ground,
+    affine       const & pose,
+    std::string  const   method,
+    budget       const & limits,
+    report             & info
+  )
+  {
+    #define CMD "enve::shell::setup(...): "
+
+    ENVE_TRACE("shell::setup");
+
+    typedef std::chrono::steady_clock clock;
+    clock::time_point start = clock::now();
+
+    // Set the new reference frame
+    affine previous(this->m_affine);
+    this->transform(pose);
+    this->updateBBox();
+
+    info = report();
+    size_t size  = this->size();
+    bool   out   = false;
+    bool   found = this->findCandidates(ground, method);
+
+    // Charge the candidates search to the budget
+    info.local  = this->m_local.size();
+    info.tests  = info.local;
+    info.search = std::chrono::duration<real>(clock::now() - start).count();
+    if (!found)
+    {
+      // No intersections, nothing to be evaluated
+      for (size_t i = 0; i < size; ++i)
+        {this->m_ribs[i].envelop(pose, this->m_out[i]);}
+      info.ribs = size;
+    }
+    else
+    {
+      // Evaluate the ribs from coarse to fine spacing until the budget is spent
+      ENVE_STATS(std::chrono::steady_clock::time_point tic = std::chrono::steady_clock::now();)
+      triangleground::vecptr const & triangles = ground.vecptrTriangleground();
+      std::fill(this->m_evaluated.begin(), this->m_evaluated.end(), false);
+      for (size_t k = 0; k < size; ++k)
+      {
+        size_t i     = this->m_order[k];
+        size_t tests = info.tests + this->m_candidates[i].size();
+        real   time  = std::chrono::duration<real>(clock::now() - start).count();
+        if (tests > limits.tests || time > limits.time)
+          {break;}
+        out = this->m_ribs[i].envelop(triangles, this->m_candidates[i], pose, method, this->m_out[i]) || out;
+        this->m_evaluated[i] = true;
+        info.tests = tests;
+        ++info.ribs;
+      }
+      ENVE_STATS(this->m_stats.time_envelop += lap(tic);)
+
+      if (info.ribs == size)
+      {
+        info.level = degradation::none;
+      }
+      else if (info.ribs > size_t(0))
+      {
+        // Interpolate the skipped ribs
+        info.level = degradation::ribs;
+        for (size_t i = 0; i < size; ++i)
+        {
+          if (!this->m_evaluated[i])
+            {this->interpolateRib(i);}
+        }
+      }
+      else
+      {
+        // Move the last step results with the shell
+        info.level = degradation::extrapolation;
+        affine motion(pose * previous.inverse());
+        for (size_t i = 0; i < size; ++i)
+        {
+          output & out_i = this->m_out[i];
+          if (out_i.point.hasNaN() || out_i.normal.hasNaN())
+          {
+            this->m_ribs[i].envelop(pose, out_i);
+          }
+          else
+          {
+            out_i.point  = motion * out_i.point;
+            out_i.normal = (motion.linear() * out_i.normal).normalized();
+            out = out || out_i.volume > real(0.0);
+          }
+        }
+      }
+    }
+    info.time = std::chrono::duration<real>(clock::now() - start).count();
+    return out;
+
+    #undef CMD
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  shell::setup(
+    ground::scene const & ground,
+    affine        const & pose,
+    std::string   const   method
+  )
+  {
+    #define CMD "enve::shell::setup(...): "
+
+    ENVE_TRACE("shell::setup");
+
+    // Find the instances under the shell
+    this->transform(pose);
+    this->updateBBox();
+    ground.intersection(*this->m_bbox, this->m_instances);
+
+    // Start from the no contact condition
+    size_t size = this->size();
+    for (size_t i = 0; i < size; ++i)
+      {this->m_ribs[i].envelop(pose, this->m_scene_out[i]);}
+
+    // Envelop each instance in its own reference frame and keep the deepest contacts
+    bool out = false;
+    for (size_t k = 0; k < this->m_instances.size(); ++k)
+    {
+      ground::scene::instance const & object = ground[this->m_instances[k]];
+
+      // Instances of the same mesh cannot share the adjacency walk seeds
+      this->m_walked = 0;
+      if (!this->setup(*object.ground, object.inverse * pose, method))
+        {continue;}
+      for (size_t i = 0; i < size; ++i)
+      {
+        output const & local = this->m_out[i];
+        output       & world = this->m_scene_out[i];
+        if (local.depth > world.depth)
+        {
+          world        = local;
+          world.point  = object.pose * local.point;
+          world.normal = object.pose.linear() * local.normal;
+          out = true;
+        }
+      }
+    }
+
+    // Restore the scene reference frame
+    this->m_walked = 0;
+    this->transform(pose);
+    this->updateBBox();
+    std::swap(this->m_out, this->m_scene_out);
+    return out;
+
+    #undef CMD
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  shell::setup(
+    ground::composite const & ground,
+    affine            const & pose,
+    std::string       const   method
+  )
+  {
+    #define CMD "enve::shell::setup(...): "
+
+    ENVE_TRACE("shell::setup");
+
+    // Set the new reference frame
+    this->transform(pose);
+    this->updateBBox();
+
+    // Gather the local triangles of the loaded tiles under the shell
+    triangleground::vecptr    & triangles = this->m_gathered;
+    std::vector<real_storage> & vertices  = this->m_packed;
+    ENVE_STATS(std::chrono::steady_clock::time_point tic = std::chrono::steady_clock::now();)
+    {
+      ENVE_TRACE("shell::query");
+      triangles.clear();
+      vertices.clear();
+      ground.intersection(*this->m_bbox, this->m_instances);
+      for (size_t k = 0; k < this->m_instances.size(); ++k)
+      {
+        if (!ground.isLoaded(this->m_instances[k]))
+          {continue;}
+        ground::mesh const & tile = *ground[this->m_instances[k]];
+        tile.intersection(*this->m_bbox, this->m_local);
+#ifdef ENVE_SINGLE_PRECISION
+        std::vector<real_storage> const & tile_vertices = tile.vecVertices();
+        vec3 offset(tile.origin() - this->translation());
+        for (size_t i = 0; i < this->m_local.size(); ++i)
+        {
+          // Move the packed vertices from the tile origin to the shell origin
+          std::uint32_t t = this->m_local[i];
+          triangles.push_back(tile[t]);
+          for (size_t j = 0; j < 9; ++j)
+            {vertices.push_back(real_storage(offset[j % 3] + real(tile_vertices[9 * t + j])));}
+        }
+#else
+        for (size_t i = 0; i < this->m_local.size(); ++i)
+        {
+          // Pack the triangle vertices relative to the shell origin
+          std::uint32_t t = this->m_local[i];
+          triangles.push_back(tile[t]);
+          for (size_t j = 0; j < 3; ++j)
+          {
+            vec3 vertex(triangles.back()->vertex(j) - this->translation());
+            vertices.insert(vertices.end(), {vertex.x(), vertex.y(), vertex.z()});
+          }
+        }
+#endif
+      }
+    }
+    ENVE_STATS(this->m_stats.time_query += lap(tic);)
+
+    // The local indices do not belong to a single mesh
+    this->m_walked = 0;
+    this->m_visits = 0;
+    return this->envelopGathered(triangles, triangles.size(), pose, method);
+
+    #undef CMD
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  shell::setup(
+    ground::compressed const & ground,
+    affine             const & pose,
+    std::string        const   method
+  )
+  {
+    #define CMD "enve::shell::setup(...): "
+
+    ENVE_TRACE("shell::setup");
+
+    // Set the new reference frame
+    this->transform(pose);
+    this->updateBBox();
+
+    // Decode the local triangles under the shell into the reused block
+    ENVE_STATS(std::chrono::steady_clock::time_point tic = std::chrono::steady_clock::now();)
+    triangleground::vecptr    & triangles = this->m_decoded;
+    std::vector<real_storage> & vertices  = this->m_packed;
+    size_t size;
+    {
+      ENVE_TRACE("shell::query");
+      ground.intersection(*this->m_bbox, this->m_local);
+      size = this->m_local.size();
+      if (triangles.size() < size)
+      {
+        // Grow the block geometrically, the aliasing pointers are set once
+        size_t capacity = std::max(size, 2 * triangles.size());
+        this->m_block.reset(new triangleground[capacity], std::default_delete<triangleground[]>());
+        triangles.resize(capacity);
+        for (size_t i = 0; i < capacity; ++i)
+          {triangles[i] = triangleground::ptr(this->m_block, this->m_block.get() + i);}
+      }
+      vertices.resize(9 * size);
+      for (size_t i = 0; i < size; ++i)
+      {
+        ground.decode(this->m_local[i], this->m_block.get()[i]);
+        ground.decode(this->m_local[i], &vertices[9 * i], this->translation());
+      }
+    }
+    ENVE_STATS(this->m_stats.time_query += lap(tic);)
+
+    // The local indices are replaced by the decoded ones
+    this->m_walked = 0;
+    this->m_visits = 0;
+    return this->envelopGathered(triangles, size, pose, method);
+
+    #undef CMD
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   bool
   shell::setup(
     ground::flat const & ground,
@@ -488,14 +920,21 @@ namespace enve
   {
     #define CMD "enve::shell::setup(...): "
 
+    ENVE_TRACE("shell::setup");
+
     // Set the new reference frame
     this->transform(pose);
     this->updateBBox();
 
     // Perform intersection on all ribs
+    ENVE_STATS(
+      std::chrono::steady_clock::time_point tic = std::chrono::steady_clock::now();
+      ++this->m_stats.setups;
+    )
     bool out = false;
     for (size_t i = 0; i < this->size(); ++i)
       {out = this->m_ribs[i].envelop(ground, pose, method, this->m_out[i]);}
+    ENVE_STATS(this->m_stats.time_envelop += lap(tic);)
     return out;
 
     #undef CMD
@@ -503,6 +942,63 @@ namespace enve
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  bool
+  shell::setup(
+    ground::mesh::future const & ground,
+    ground::flat         const & backup,
+    affine               const & pose,
+    std::string          const   method
+  )
+  {
+    #define CMD "enve::shell::setup(...): "
+
+    ENVE_TRACE("shell::setup");
+
+    // Use the mesh as soon as it is loaded
+    if (ground::mesh::isReady(ground) && this->setup(*ground.get(), pose, method))
+      {return true;}
+
+    // Use the back-up plane otherwise
+    this->setup(backup, pose, method);
+    return false;
+
+    #undef CMD
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  shell::setup(
+    ground::container const & ground,
+    ground::flat      const & backup,
+    affine            const & pose,
+    std::string       const   method
+  )
+  {
+    #define CMD "enve::shell::setup(...): "
+
+    ENVE_TRACE("shell::setup");
+
+    // Take the published mesh snapshot for the whole step, the replaced snapshot
+    // is handed to the container so that its last release never happens here
+    ground::mesh::ptr snapshot(ground.get());
+    if (snapshot != this->m_ground)
+    {
+      ground.retire(std::move(this->m_ground));
+      this->m_ground = std::move(snapshot);
+    }
+    if (this->m_ground && this->setup(*this->m_ground, pose, method))
+      {return true;}
+
+    // Use the back-up plane otherwise
+    this->setup(backup, pose, method);
+    return false;
+
+    #undef CMD
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   /*\
    |                   _             _
    |    ___ ___  _ __ | |_ __ _  ___| |_
@@ -520,6 +1016,7 @@ namespace enve
   )
     const
   {
+    ENVE_TRACE("shell::contactPoint");
     point           = (ZEROS_VEC3);
     size_t size     = this->size();
     real volume_sum = 0.0;
@@ -572,6 +1069,7 @@ namespace enve
   )
     const
   {
+    ENVE_TRACE("shell::contactNormal");
     normal = ZEROS_VEC3;
     size_t size = this->size();
     real volume;
@@ -626,6 +1124,7 @@ namespace enve
   )
     const
   {
+    ENVE_TRACE("shell::contactFriction");
     friction        = 0.0;
     size_t size     = this->size();
     real volume_sum = 0.0;
@@ -678,6 +1177,7 @@ namespace enve
   )
     const
   {
+    ENVE_TRACE("shell::contactDepth");
     depth           = 0.0;
     size_t size     = this->size();
     real volume_sum = 0.0;
@@ -806,6 +1306,7 @@ namespace enve
   )
     const
   {
+    ENVE_TRACE("shell::contactPointAffine");
     point point;
     vec3  normal;
     this->contactPoint(point);
@@ -1001,54 +1502,316 @@ namespace enve
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  bool
+  shell::findCandidates(
+    ground::mesh const & ground,
+    std::string  const   method
+  )
+  {
+    // Local intersected triangles indices vector
+    ENVE_STATS(
+      std::chrono::steady_clock::time_point tic = std::chrono::steady_clock::now();
+      ++this->m_stats.setups;
+    )
+    triangleground::vecidx & local_ground = this->m_local;
+    {
+      ENVE_TRACE("shell::query");
+      if (!this->m_warm_start || !this->walkIntersection(ground, local_ground))
+      {
+        this->m_visits = 0;
+        ground.intersection(*this->m_bbox, local_ground);
+      }
+    }
+    this->m_walked = ground.generation();
+    ENVE_STATS(
+      this->m_stats.time_query += lap(tic);
+      this->m_stats.queried    += local_ground.size();
+    )
+    if (local_ground.empty())
+      {return false;}
+
+    // Calculate ribs candidates to speed up calculations
+    bool refine = method == "geometric" && local_ground.size() > integer(3);
+#ifdef ENVE_SINGLE_PRECISION
+    real_storage const * packed = ground.vecVertices().data();
+    this->refineIntersection(
+      [packed](std::uint32_t t, real_storage *) {return packed + 9 * std::size_t(t);},
+      ground.origin(), local_ground, refine);
+#else
+    // Double precision meshes keep no packed copy, read the triangles vertices
+    triangleground::vecptr const & triangles = ground.vecptrTriangleground();
+    point                  const & origin    = this->translation();
+    this->refineIntersection(
+      [&triangles, &origin](std::uint32_t t, real_storage * buffer) -> real_storage const * {
+        triangleground const & triangle = *triangles[t];
+        for (size_t j = 0; j < 3; ++j)
+        {
+          vec3 vertex(triangle.vertex(j) - origin);
+          buffer[3*j] = vertex.x(); buffer[3*j+1] = vertex.y(); buffer[3*j+2] = vertex.z();
+        }
+        return buffer;
+      }, origin, local_ground, refine);
+#endif
+    ENVE_STATS(this->m_stats.time_refine += lap(tic);)
+    return true;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  shell::interpolateRib(
+    size_t i
+  )
+  {
+    // Find the nearest evaluated ribs on both sides
+    size_t size = this->size();
+    size_t l = i, r = i;
+    bool has_l = false, has_r = false;
+    for (size_t j = i; j-- > 0;)
+      {if (this->m_evaluated[j]) {l = j; has_l = true; break;}}
+    for (size_t j = i + 1; j < size; ++j)
+      {if (this->m_evaluated[j]) {r = j; has_r = true; break;}}
+
+    output & out  = this->m_out[i];
+    real     y_i  = this->m_ribs[i].center().y();
+    if (has_l && has_r)
+    {
+      // Linear interpolation between the two evaluated ribs
+      output const & out_l = this->m_out[l];
+      output const & out_r = this->m_out[r];
+      real y_l = this->m_ribs[l].center().y();
+      real y_r = this->m_ribs[r].center().y();
+      real t   = (y_i - y_l) / (y_r - y_l);
+      out.point    = (real(1.0) - t) * out_l.point    + t * out_r.point;
+      out.normal   = ((real(1.0) - t) * out_l.normal  + t * out_r.normal).normalized();
+      out.friction = (real(1.0) - t) * out_l.friction + t * out_r.friction;
+      out.depth    = (real(1.0) - t) * out_l.depth    + t * out_r.depth;
+      out.area     = (real(1.0) - t) * out_l.area     + t * out_r.area;
+      out.volume   = (real(1.0) - t) * out_l.volume   + t * out_r.volume;
+    }
+    else if (has_l || has_r)
+    {
+      // Copy the nearest evaluated rib and shift its contact point laterally
+      size_t j = has_l ? l : r;
+      out = this->m_out[j];
+      out.point += this->y() * (y_i - this->m_ribs[j].center().y());
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  shell::walkIntersection(
+    ground::mesh           const & ground,
+    triangleground::vecidx       & local_ground
+  )
+  {
+    // Walk only from the last local triangles of the same mesh generation, and
+    // only through a few components (their boxes are checked at every walk)
+    triangleground::vecptr const & triangles = ground.vecptrTriangleground();
+    std::vector<aabb>      const & regions   = ground.components();
+    if (this->m_walked != ground.generation() || local_ground.empty() || regions.size() > size_t(64))
+      {return false;}
+
+    // Clear the visited set
+    if (this->m_visited.empty())
+      {this->m_visited.resize(64);}
+    std::fill(this->m_visited.begin(), this->m_visited.end(), NONE_INDEX);
+    this->m_visits = 0;
+
+    // Footprint (xy-plane) overlap with the shell bounding box
+    aabb const & box = *this->m_bbox;
+    auto overlaps = [&box](aabb const & b) -> bool {
+      return b.min().x() <= box.max().x() && b.max().x() >= box.min().x() &&
+             b.min().y() <= box.max().y() && b.max().y() >= box.min().y();
+    };
+
+    // Keep the seeds whose footprint still overlaps the bounding box
+    this->m_seeded.assign(regions.size(), false);
+    size_t size = 0;
+    for (size_t i = 0; i < local_ground.size(); ++i)
+    {
+      std::uint32_t t = local_ground[i];
+      if (t >= triangles.size())
+        {return false;}
+      if (this->visit(t) && overlaps(triangles[t]->bbox()))
+      {
+        local_ground[size++] = t;
+        this->m_seeded[ground.component(t)] = true;
+      }
+    }
+    local_ground.resize(size);
+
+    // Fail if the bounding box reaches a component without seeds
+    for (size_t c = 0; c < regions.size(); ++c)
+    {
+      if (!this->m_seeded[c] && regions[c].intersects(box))
+        {return false;}
+    }
+
+    // Breadth-first walk through the edge-neighbours overlapping the footprint
+    std::uint32_t n;
+    for (size_t i = 0; i < local_ground.size(); ++i)
+    {
+      for (size_t j = 0; j < 3; ++j)
+      {
+        n = ground.neighbour(local_ground[i], j);
+        if (n != NONE_INDEX && this->visit(n) && overlaps(triangles[n]->bbox()))
+          {local_ground.push_back(n);}
+      }
+    }
+
+    // Keep the triangles overlapping the bounding box
+    local_ground.erase(std::remove_if(local_ground.begin(), local_ground.end(),
+      [&triangles, &box](std::uint32_t t) {return !triangles[t]->bbox().intersects(box);}),
+      local_ground.end());
+    return true;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  shell::visit(
+    std::uint32_t i
+  )
+  {
+    // Grow the set and rehash when half full
+    if (2 * (this->m_visits + 1) > this->m_visited.size())
+    {
+      std::vector<std::uint32_t> visited(2 * this->m_visited.size(), NONE_INDEX);
+      visited.swap(this->m_visited);
+      this->m_visits = 0;
+      for (size_t k = 0; k < visited.size(); ++k)
+        {if (visited[k] != NONE_INDEX) {this->visit(visited[k]);}}
+    }
+
+    // Linear probing from the multiplicative hash of the index
+    size_t mask = this->m_visited.size() - 1;
+    for (size_t k = (size_t(i) * size_t(2654435761u)) & mask;; k = (k + 1) & mask)
+    {
+      if (this->m_visited[k] == i)
+        {return false;}
+      if (this->m_visited[k] == NONE_INDEX)
+      {
+        this->m_visited[k] = i;
+        ++this->m_visits;
+        return true;
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  shell::envelopGathered(
+    triangleground::vecptr const & triangles,
+    size_t                         size,
+    affine                 const & pose,
+    std::string            const   method
+  )
+  {
+    // End setup if there are no intersections
+    triangleground::vecidx & local_ground = this->m_local;
+    local_ground.resize(size);
+    ENVE_STATS(
+      std::chrono::steady_clock::time_point tic = std::chrono::steady_clock::now();
+      ++this->m_stats.setups;
+      this->m_stats.queried += local_ground.size();
+    )
+    if (local_ground.empty())
+    {
+      for (size_t i = 0; i < this->size(); ++i)
+        {this->m_ribs[i].envelop(pose, this->m_out[i]);}
+      return false;
+    }
+
+    // Calculate ribs candidates to speed up calculations
+    for (size_t i = 0; i < local_ground.size(); ++i)
+      {local_ground[i] = std::uint32_t(i);}
+    real_storage const * packed = this->m_packed.data();
+    this->refineIntersection(
+      [packed](std::uint32_t t, real_storage *) {return packed + 9 * std::size_t(t);},
+      this->translation(), local_ground, method == "geometric" && local_ground.size() > integer(3));
+    ENVE_STATS(this->m_stats.time_refine += lap(tic);)
+
+    // Perform intersection on all ribs
+    bool out = false;
+    for (size_t i = 0; i < this->size(); ++i)
+      {out = this->m_ribs[i].envelop(triangles, this->m_candidates[i], pose, method, this->m_out[i]) || out;}
+    ENVE_STATS(this->m_stats.time_envelop += lap(tic);)
+    return out;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  template <typename Fetch>
   void
   shell::refineIntersection(
-    triangleground::vecptr const & local_ground,
+    Fetch                  const & fetch,
+    point                  const & origin,
+    triangleground::vecidx const & local_ground,
     bool                           refine
   )
   {
     size_t size = this->size();
-    std::vector<real> y(size);
+    std::vector<real_storage> & y = this->m_ribs_y;
     for (size_t i = 0; i < size; ++i)
     {
       if (!this->m_candidates[i].empty())
         {this->m_candidates[i].clear();}
-      y[i] = this->m_ribs[i].center().y();
+      y[i] = real_storage(this->m_ribs[i].center().y());
+    }
+
+    // Workaround for skip advanced ribs refinement
+    if (!refine)
+    {
+      for (size_t j = 0; j < size; ++j)
+        {this->m_candidates[j] = local_ground;}
+      ENVE_STATS(this->m_stats.candidates += size * local_ground.size();)
+      return;
     }
 
-    // Create shell middle plane
-    plane mid_plane(this->translation(), this->y());
-    mid_plane.normalize();
+    // Create shell middle plane in storage precision, its distance from the vertices
+    // origin is computed in full precision so that no large coordinates cancel out
+    vec3 normal(this->y().normalized());
+    real_storage n_x = real_storage(normal.x());
+    real_storage n_y = real_storage(normal.y());
+    real_storage n_z = real_storage(normal.z());
+    real_storage n_d = real_storage(normal.dot(this->translation() - origin));
+
+    // Distances within the storage rounding error of the local coordinates are
+    // treated as zero, so that the prefilter never drops a crossing triangle
+    vec3 extent(this->m_bbox->max() - this->m_bbox->min());
+    real_storage margin = real_storage(real(8.0) * real(std::numeric_limits<real_storage>::epsilon()) *
+      ((this->translation() - origin).norm() + extent.norm()));
 
     // Iterate on triangles
-    real d0, d1, d2, sum;
+    real_storage d0, d1, d2, sum, buffer[9];
     for (size_t i = 0; i < local_ground.size(); ++i)
     {
       // Calculate distance of i-th triangle
-      d0 = mid_plane.signedDistance(local_ground[i]->vertex(0));
-      d1 = mid_plane.signedDistance(local_ground[i]->vertex(1));
-      d2 = mid_plane.signedDistance(local_ground[i]->vertex(2));
+      real_storage const * v = fetch(local_ground[i], buffer);
+      d0 = n_x * v[0] + n_y * v[1] + n_z * v[2] - n_d;
+      d1 = n_x * v[3] + n_y * v[4] + n_z * v[5] - n_d;
+      d2 = n_x * v[6] + n_y * v[7] + n_z * v[8] - n_d;
 
       // Iterate on ribs
       for (size_t j = 0; j < size; ++j)
       {
-        // Workaround for skip advanced ribs refinement
-        if (!refine)
-        {
-          this->m_candidates[j].push_back(local_ground[i]);
-          continue;
-        }
-
         // Calculate sign of j-th rib distance
-        sum = real((real(0.0) < (d0-y[j])) - ((d0-y[j]) < real(0.0))) +
-              real((real(0.0) < (d1-y[j])) - ((d1-y[j]) < real(0.0))) +
-              real((real(0.0) < (d2-y[j])) - ((d2-y[j]) < real(0.0)));
+        sum = real_storage((margin < (d0-y[j])) - ((d0-y[j]) < -margin)) +
+              real_storage((margin < (d1-y[j])) - ((d1-y[j]) < -margin)) +
+              real_storage((margin < (d2-y[j])) - ((d2-y[j]) < -margin));
 
         // Fill candidates list
-        if (real(-3.0) < sum && sum < real(3.0))
+        if (real_storage(-3.0) < sum && sum < real_storage(3.0))
           {this->m_candidates[j].push_back(local_ground[i]);}
       }
     }
+    ENVE_STATS(
+      for (size_t j = 0; j < size; ++j)
+        {this->m_stats.candidates += this->m_candidates[j].size();}
+    )
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
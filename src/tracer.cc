@@ -0,0 +1,254 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: tracer.cc
+///
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "enve.hh"
+
+namespace enve
+{
+
+ /*\
+  |   _
+  |  | |_  _ __   __ _   ___   ___  _ __
+  |  | __|| '__| / _` | / __| / _ \| '__|
+  |  | |_ | |   | (_| || (__ |  __/| |
+  |   \__||_|    \__,_| \___| \___||_|
+  |
+ \*/
+
+  //! Thread ring buffer data structure (written by its own thread only)
+  struct ring
+  {
+    std::vector<tracer::event> events; //!< Events storage (power of two size)
+    std::atomic<std::uint64_t> head;   //!< Events written so far
+    std::uint32_t              thread; //!< Trace thread identifier
+  };
+
+  static std::atomic<bool>                  s_enabled(false);   //!< Recording flag
+  static std::atomic<size_t>                s_capacity(65536);  //!< New buffers capacity
+  static std::mutex                         s_mutex;            //!< Buffers registration mutex
+  static std::vector<std::unique_ptr<ring>> s_rings;            //!< Buffers (kept after their thread exits)
+  static thread_local ring *                s_local = nullptr;  //!< Calling thread buffer
+
+  static std::chrono::steady_clock::time_point const s_origin = std::chrono::steady_clock::now(); //!< Tracer time origin
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  tracer::span::span(
+    char const * name
+  )
+    : m_name(s_enabled.load(std::memory_order_relaxed) ? name : nullptr),
+      m_begin(m_name != nullptr ? tracer::now() : std::uint64_t(0))
+  {
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  tracer::span::~span(void)
+  {
+    if (this->m_name != nullptr)
+      {tracer::record(this->m_name, this->m_begin, tracer::now());}
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  tracer::hasTrace(void)
+  {
+#ifdef ENVE_TRACING
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  tracer::start(
+    size_t capacity
+  )
+  {
+    #define CMD "enve::tracer::start(...): "
+
+    ENVE_ASSERT(capacity > size_t(0),
+      CMD "zero capacity detected.");
+
+    size_t size = 1;
+    while (size < capacity)
+      {size *= 2;}
+    s_capacity.store(size);
+    s_enabled.store(true);
+
+    #undef CMD
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  tracer::stop(void)
+  {
+    s_enabled.store(false);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  tracer::isEnabled(void)
+  {
+    return s_enabled.load();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  tracer::clear(void)
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    for (size_t i = 0; i < s_rings.size(); ++i)
+      {s_rings[i]->head.store(std::uint64_t(0));}
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  size_t
+  tracer::size(void)
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    size_t size = 0;
+    for (size_t i = 0; i < s_rings.size(); ++i)
+      {size += size_t(std::min<std::uint64_t>(s_rings[i]->head.load(), s_rings[i]->events.size()));}
+    return size;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  size_t
+  tracer::threads(void)
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    size_t size = 0;
+    for (size_t i = 0; i < s_rings.size(); ++i)
+      {size += s_rings[i]->head.load() > 0;}
+    return size;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  tracer::record(
+    char const *  name,
+    std::uint64_t begin,
+    std::uint64_t end
+  )
+  {
+    // Register the calling thread buffer on its first event
+    ring * buffer = s_local;
+    if (buffer == nullptr)
+    {
+      std::unique_ptr<ring> created(new ring());
+      created->events.resize(s_capacity.load());
+      created->head.store(std::uint64_t(0));
+      std::lock_guard<std::mutex> lock(s_mutex);
+      created->thread = std::uint32_t(s_rings.size() + 1);
+      buffer = s_local = created.get();
+      s_rings.push_back(std::move(created));
+    }
+
+    // Overwrite the oldest event when full, then publish
+    std::uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    tracer::event & slot = buffer->events[head & (buffer->events.size() - 1)];
+    slot.name  = name;
+    slot.begin = begin;
+    slot.end   = end;
+    buffer->head.store(head + 1, std::memory_order_release);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  std::uint64_t
+  tracer::now(void)
+  {
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - s_origin).count());
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  tracer::write(
+    std::string const & path
+  )
+  {
+    std::ofstream file(path);
+    if (!file.is_open())
+      {return false;}
+
+    // Complete events in microseconds, one track per thread
+    std::lock_guard<std::mutex> lock(s_mutex);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char line[256];
+    for (size_t i = 0; i < s_rings.size(); ++i)
+    {
+      ring const & buffer = *s_rings[i];
+      std::uint64_t head  = buffer.head.load(std::memory_order_acquire);
+      std::uint64_t size  = buffer.events.size();
+      if (head == 0)
+        {continue;}
+      std::snprintf(line, sizeof(line),
+        "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"enve %u\"}}",
+        first ? "" : ",", buffer.thread, buffer.thread);
+      file << line;
+      first = false;
+      for (std::uint64_t k = head > size ? head - size : 0; k < head; ++k)
+      {
+        tracer::event const & e = buffer.events[k & (size - 1)];
+        std::snprintf(line, sizeof(line),
+          ",\n{\"name\":\"%s\",\"cat\":\"enve\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+          e.name, e.begin / 1000.0, (e.end - e.begin) / 1000.0, buffer.thread);
+        file << line;
+      }
+    }
+    file << "\n]}\n";
+    return file.good();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace enve
+
+#endif
+
+///
+/// eof: tracer.cc
+///
@@ -0,0 +1,277 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_bench_00.cc
+///
+
+#include "enve.hh"
+
+#include <iomanip>
+
+using namespace acme;
+using namespace enve;
+
+// Benchmark stage samples and statistics
+struct stage
+{
+  std::string       name;    // Stage name
+  std::string       unit;    // Samples unit
+  std::vector<real> samples; // Timing samples
+
+  real mean(void) const
+  {
+    real sum = 0.0;
+    for (size_t i = 0; i < samples.size(); ++i) {sum += samples[i];}
+    return sum / samples.size();
+  }
+
+  real stddev(void) const
+  {
+    real m = this->mean(), sum = 0.0;
+    for (size_t i = 0; i < samples.size(); ++i) {sum += (samples[i] - m) * (samples[i] - m);}
+    return std::sqrt(sum / samples.size());
+  }
+
+  real percentile(real p) const
+  {
+    std::vector<real> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[std::min(sorted.size() - 1, size_t(p * (sorted.size() - 1) + 0.5))];
+  }
+};
+
+// Stopwatch returning the elapsed time in the given unit
+template <typename Unit>
+class stopwatch
+{
+  std::chrono::steady_clock::time_point m_start;
+
+public:
+  void tic(void) {m_start = std::chrono::steady_clock::now();}
+  real toc(void) const {return std::chrono::duration<real, Unit>(std::chrono::steady_clock::now() - m_start).count();}
+};
+
+// Main function
+int
+main(
+  int          argc,
+  char const * argv[]
+)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "BENCH 00 - ENVE CONTACT PIPELINE STAGES" << std::endl
+      << std::endl;
+
+    // Output files prefix
+    std::string prefix(argc > 1 ? argv[1] : "./enve_bench_00");
+
+    // Generated ground and trajectory
+    size_t steps = 2000, repeats = 3;
+    ground::generator::parameters data;
+    data.length    = 20.0;
+    data.width     = 10.0;
+    data.roughness = 'B';
+    std::string path("./enve_bench_00.obj");
+    ground::generator(data).write(path);
+    std::vector<affine> poses(steps);
+    for (size_t k = 0; k < steps; ++k)
+    {
+      poses[k] = translate(1.0 + (data.length - 2.0) * k / steps, 1.0 + (data.width - 2.0) * ((k * 37) % steps) / steps, 0.3) *
+                 angleaxis(0.1, UNITZ_VEC3);
+    }
+
+    stopwatch<std::milli> ms;
+    stopwatch<std::micro> us;
+    std::vector<stage> stages = {
+      {"mesh_load",           "ms", {}},
+      {"tree_build",          "ms", {}},
+      {"bbox_query",          "us", {}},
+      {"candidates",          "us", {}},
+      {"refine_intersection", "us", {}},
+      {"envelop_geometric",   "us", {}},
+      {"envelop_sampling",    "us", {}},
+      {"output_aggregation",  "us", {}},
+      {"setup_geometric",     "us", {}}
+    };
+
+    // Mesh load and tree build
+    ground::mesh road;
+    for (size_t r = 0; r < repeats; ++r)
+    {
+      ground::mesh loaded;
+      ms.tic();
+      loaded.load(path, 1.0);
+      stages[0].samples.push_back(ms.toc());
+    }
+    road.load(path, 1.0);
+    std::remove(path.c_str());
+    for (size_t r = 0; r < repeats; ++r)
+    {
+      ms.tic();
+      road.buildAABBtree();
+      stages[1].samples.push_back(ms.toc());
+    }
+
+    // Per-step stages (cold candidates search)
+    shell tire(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    tire.warmStart(false);
+    std::vector<rib> ribs;
+    for (size_t i = 0; i < tire.size(); ++i)
+      {ribs.emplace_back(i, tire.ribRadius(i), tire.ribCenter(i).y(), tire.ribWidth(i), tire.ribAngle(i));}
+    triangleground::vecptr const & triangles = road.vecptrTriangleground();
+    triangleground::vecidx indices;
+    output out;
+    point  contact_point;
+    vec3   contact_normal, relative_angles;
+    real   friction, depth, area, volume;
+    affine contact_pose;
+    real   candidates = 0.0;
+    for (size_t k = 0; k < steps; ++k)
+    {
+      affine const & pose = poses[k];
+
+      // Candidates search (tree query and refineIntersection)
+      us.tic();
+      tire.setupCandidates(road, pose, "geometric");
+      stages[3].samples.push_back(us.toc());
+
+      us.tic();
+      road.intersection(*tire.bbox(), indices);
+      stages[2].samples.push_back(us.toc());
+
+      // Candidates search without the tree query (refineIntersection)
+      stages[4].samples.push_back(std::max(real(0.0), stages[3].samples.back() - stages[2].samples.back()));
+
+      us.tic();
+      for (size_t i = 0; i < ribs.size(); ++i)
+        {ribs[i].envelop(triangles, tire.ribCandidates(i), pose, "geometric", out);}
+      stages[5].samples.push_back(us.toc());
+
+      us.tic();
+      for (size_t i = 0; i < ribs.size(); ++i)
+        {ribs[i].envelop(triangles, tire.ribCandidates(i), pose, "sampling", out);}
+      stages[6].samples.push_back(us.toc());
+
+      for (size_t i = 0; i < ribs.size(); ++i)
+        {candidates += real(tire.ribCandidates(i).size()) / ribs.size() / steps;}
+
+      tire.setup(road, pose, "geometric");
+      us.tic();
+      tire.contactPoint(contact_point);
+      tire.contactNormal(contact_normal);
+      tire.contactFriction(friction);
+      tire.contactDepth(depth);
+      tire.contactArea(area);
+      tire.contactVolume(volume);
+      tire.contactPointAffine(contact_pose);
+      tire.relativeAngles(relative_angles);
+      stages[7].samples.push_back(us.toc());
+
+      us.tic();
+      tire.setup(road, pose, "geometric");
+      stages[8].samples.push_back(us.toc());
+    }
+
+    // Print the results table
+    std::cout
+      << "Triangles               = " << road.size() << std::endl
+      << "Steps                   = " << steps << std::endl
+      << "Avg. candidates per rib = " << candidates << std::endl
+      << std::endl;
+    for (size_t s = 0; s < stages.size(); ++s)
+    {
+      stage const & st = stages[s];
+      std::cout
+        << std::left << std::setw(21) << st.name << std::right
+        << " mean " << std::setw(10) << st.mean()
+        << " p50 "  << std::setw(10) << st.percentile(0.50)
+        << " p95 "  << std::setw(10) << st.percentile(0.95)
+        << " "      << st.unit << std::endl;
+    }
+
+    // Write the machine-readable results
+    std::ofstream csv(prefix + ".csv");
+    csv << "stage,unit,samples,mean,stddev,min,p50,p95,max" << std::endl;
+    std::ofstream json(prefix + ".json");
+    json << "{" << std::endl
+         << "  \"benchmark\": \"enve_bench_00\"," << std::endl
+         << "  \"triangles\": " << road.size() << "," << std::endl
+         << "  \"steps\": " << steps << "," << std::endl
+         << "  \"candidates_per_rib\": " << candidates << "," << std::endl
+         << "  \"stages\": [" << std::endl;
+    for (size_t s = 0; s < stages.size(); ++s)
+    {
+      stage const & st = stages[s];
+      csv << st.name << "," << st.unit << "," << st.samples.size() << "," << st.mean() << "," << st.stddev() << ","
+          << st.percentile(0.0) << "," << st.percentile(0.5) << "," << st.percentile(0.95) << "," << st.percentile(1.0) << std::endl;
+      json << "    {\"stage\": \"" << st.name << "\", \"unit\": \"" << st.unit << "\", \"samples\": " << st.samples.size()
+           << ", \"mean\": " << st.mean() << ", \"stddev\": " << st.stddev() << ", \"min\": " << st.percentile(0.0)
+           << ", \"p50\": " << st.percentile(0.5) << ", \"p95\": " << st.percentile(0.95) << ", \"max\": " << st.percentile(1.0)
+           << "}" << (s + 1 < stages.size() ? "," : "") << std::endl;
+    }
+    json << "  ]" << std::endl << "}" << std::endl;
+    bool passed = csv.good() && json.good();
+
+    // End of test
+    std::cout
+      << std::endl
+      << "Results written to " << prefix << ".{csv,json}" << std::endl
+      << std::endl
+      << "BENCH 00: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_bench_00.cc
+///
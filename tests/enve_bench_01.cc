@@ -0,0 +1,196 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_bench_01.cc
+///
+
+#include "enve.hh"
+
+#include <iomanip>
+
+using namespace acme;
+using namespace enve;
+
+// Footprint report row
+struct row
+{
+  std::string layout;    // Ground layout name
+  size_t      triangles; // Represented triangles (of the full resolution road)
+  footprint   usage;     // Memory footprint
+};
+
+// Main function
+int
+main(
+  int          argc,
+  char const * argv[]
+)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "BENCH 01 - ENVE MEMORY FOOTPRINT" << std::endl
+      << std::endl;
+
+    // Output files prefix
+    std::string prefix(argc > 1 ? argv[1] : "./enve_bench_01");
+
+    // Ground layouts for generated roads of growing density
+    std::vector<row> rows;
+    real spacings[3] = {0.1, 0.05, 0.025};
+    for (size_t k = 0; k < 3; ++k)
+    {
+      ground::generator::parameters data;
+      data.length    = 50.0;
+      data.width     = 4.0;
+      data.spacing   = spacings[k];
+      data.roughness = 'B';
+      ground::generator road(data);
+      ground::mesh::ptr full(road.build());
+      std::string tag(" (d = " + std::to_string(spacings[k]).substr(0, 5) + " m)");
+
+      // Current layout
+      rows.push_back({"mesh" + tag, full->size(), full->memoryUsage()});
+
+      // Quantized layout
+      ground::compressed packed(*full);
+      rows.push_back({"compressed" + tag, full->size(), packed.memoryUsage()});
+
+      // Decimated layout (bytes per full resolution triangle)
+      ground::decimator simplified(*full);
+      simplified.simplify(1.0e-3);
+      ground::mesh decimated(simplified.triangles());
+      rows.push_back({"decimated 1 mm" + tag, full->size(), decimated.memoryUsage()});
+    }
+
+    // Shell buffers after a setup on the densest road
+    ground::generator::parameters data;
+    data.length  = 10.0;
+    data.spacing = 0.025;
+    ground::mesh::ptr road(ground::generator(data).build());
+    size_t ribs[3] = {1, 10, 50};
+    for (size_t k = 0; k < 3; ++k)
+    {
+      shell tire_shell(ribs[k], 0.327, 4.0, 0.195, 4.0, 0.188);
+      tire_shell.setup(*road, affine(translate(5.0, 2.0, 0.3)), "geometric");
+      rows.push_back({"shell " + std::to_string(ribs[k]) + " ribs", 0, tire_shell.memoryUsage()});
+    }
+
+    // Storage precision tradeoff: single precision builds keep a packed copy of
+    // the vertices for the candidates prefilter (and round the tree boxes to
+    // float), double precision builds read the prefilter vertices from the
+    // triangles. Run the bench in both builds to compare memory and setup time.
+    shell  tire_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    size_t steps = 2000;
+    std::chrono::steady_clock::time_point tic = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < steps; ++k)
+      {tire_shell.setup(*road, affine(translate(1.0 + (8.0 * k) / steps, 2.0, 0.3)), "geometric");}
+    real      setup_time = lap(tic) / steps;
+    footprint precision(road->memoryUsage());
+    real      road_n     = real(road->size());
+
+    // Report
+    std::ofstream file(prefix + ".csv");
+    file
+      << "layout,triangles,triangle_objects,control_blocks,pointers,vertices,adjacency,boxes,nodes,indices,"
+      << "candidates,other,total,bytes_per_triangle" << std::endl;
+    std::cout
+      << std::left << std::setw(28) << "layout" << std::right << std::setw(10) << "triangles" << std::setw(14) << "total [B]"
+      << std::setw(12) << "B/triangle" << std::endl;
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+      footprint const & u = rows[i].usage;
+      real per_triangle = rows[i].triangles > 0 ? real(u.total()) / rows[i].triangles : 0.0;
+      file
+        << rows[i].layout << "," << rows[i].triangles << "," << u.triangles << "," << u.control << "," << u.pointers << ","
+        << u.vertices << "," << u.adjacency << "," << u.boxes << "," << u.nodes << "," << u.indices << ","
+        << u.candidates << "," << u.other << "," << u.total() << "," << per_triangle << std::endl;
+      std::cout
+        << std::left << std::setw(28) << rows[i].layout << std::right << std::setw(10) << rows[i].triangles
+        << std::setw(14) << u.total() << std::setw(12) << std::fixed << std::setprecision(1) << per_triangle << std::endl;
+      std::cout.unsetf(std::ios::fixed);
+      std::cout << std::setprecision(6);
+    }
+
+    // Current layout breakdown per triangle
+    footprint const & u = rows[0].usage;
+    real n = real(rows[0].triangles);
+    std::cout
+      << std::endl
+      << "Mesh bytes per triangle breakdown (" << sizeof(real_storage) << "-byte packed vertices)" << std::endl
+      << "  triangle objects = " << u.triangles / n << std::endl
+      << "  control blocks   = " << u.control / n << std::endl
+      << "  pointers         = " << u.pointers / n << std::endl
+      << "  vertices         = " << u.vertices / n << std::endl
+      << "  adjacency        = " << u.adjacency / n << std::endl
+      << "  boxes            = " << u.boxes / n << std::endl
+      << "  tree nodes       = " << u.nodes / n << std::endl
+      << "  tree indices     = " << u.indices / n << std::endl
+      << std::endl
+      << "Storage precision tradeoff (" << (sizeof(real_storage) == sizeof(float) ? "single" : "double") << " precision build)" << std::endl
+      << "  packed vertices  = " << precision.vertices / road_n << " B/triangle" << std::endl
+      << "  tree boxes       = " << precision.boxes / road_n << " B/triangle (triangles boxes included)" << std::endl
+      << "  mesh total       = " << precision.total() / road_n << " B/triangle" << std::endl
+      << "  geometric setup  = " << 1.0e6 * setup_time << " us" << std::endl
+      << std::endl
+      << "Results written to " << prefix << ".csv" << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "BENCH 01: Completed" << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return 0;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_bench_01.cc
+///
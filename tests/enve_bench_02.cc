@@ -0,0 +1,252 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_bench_02.cc
+///
+
+#include "enve.hh"
+
+#include <iomanip>
+
+using namespace acme;
+using namespace enve;
+
+// Split a comma separated list
+std::vector<std::string>
+split(
+  std::string const & value
+)
+{
+  std::vector<std::string> items;
+  std::stringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ','))
+    {items.push_back(item);}
+  return items;
+}
+
+// Pose of the k-th step of the i-th shell trajectory (independent lanes and phases)
+affine
+trajectory(
+  size_t i,
+  size_t k,
+  real   length,
+  real   width
+)
+{
+  real lanes = std::floor((width - 1.0) / 0.5);
+  real x = 1.0 + std::fmod(1.37 * i + (0.02 + 0.001 * (i % 7)) * k, length - 2.0);
+  real y = 0.5 + 0.5 * std::fmod(real(i), lanes) + 0.1 * std::sin(0.3 * x + i) + 0.0071;
+  return translate(x, y, 0.3) * angleaxis(0.05 * std::sin(0.5 * x), UNITZ_VEC3);
+}
+
+// Run K shells split over T threads against the given meshes (shell-steps per second)
+real
+run(
+  std::vector<ground::mesh::ptr> const & meshes,  // One shared mesh or one mesh per thread
+  size_t                                 shells,
+  size_t                                 threads,
+  size_t                                 steps,
+  size_t                                 ribs,
+  std::string                    const & method,
+  bool                                   local,   // Shells allocated by their own thread
+  real                                   length,
+  real                                   width
+)
+{
+  std::vector<std::unique_ptr<shell>> packed;
+  if (!local)
+  {
+    for (size_t i = 0; i < shells; ++i)
+      {packed.emplace_back(new shell(ribs, 0.327, 4.0, 0.195, 4.0, 0.188));}
+  }
+  std::atomic<size_t> ready(0);
+  std::atomic<bool>   go(false);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&, t]() {
+      // Static partition of the shells
+      size_t first = shells * t / threads, last = shells * (t + 1) / threads;
+      ground::mesh const & road = *meshes[meshes.size() == 1 ? 0 : t];
+      std::vector<std::unique_ptr<shell>> owned;
+      std::vector<shell *> mine;
+      for (size_t i = first; i < last; ++i)
+      {
+        if (local) {owned.emplace_back(new shell(ribs, 0.327, 4.0, 0.195, 4.0, 0.188)); mine.push_back(owned.back().get());}
+        else       {mine.push_back(packed[i].get());}
+      }
+      point contact_point;
+      ++ready;
+      while (!go.load()) {std::this_thread::yield();}
+      for (size_t k = 0; k < steps; ++k)
+      {
+        for (size_t i = 0; i < mine.size(); ++i)
+        {
+          mine[i]->setup(road, trajectory(first + i, k, length, width), method);
+          mine[i]->contactPoint(contact_point);
+        }
+      }
+    });
+  }
+  while (ready.load() < threads) {std::this_thread::yield();}
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  go.store(true);
+  for (size_t t = 0; t < threads; ++t)
+    {workers[t].join();}
+  real elapsed = std::chrono::duration<real>(std::chrono::steady_clock::now() - start).count();
+  return shells * steps / elapsed;
+}
+
+// Main function
+int
+main(
+  int          argc,
+  char const * argv[]
+)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "BENCH 02 - ENVE PARALLEL SCALING" << std::endl
+      << std::endl;
+
+    // Options (key=value, lists comma separated), the first plain argument is the output prefix
+    std::string prefix("./enve_bench_02"), method("geometric");
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    size_t shells = 64, steps = 200, ribs = 10;
+    real   spacing = 0.05;
+    std::vector<size_t> threads;
+    for (int k = 1; k < argc; ++k)
+    {
+      std::string argument(argv[k]);
+      size_t equal = argument.find('=');
+      if (equal == std::string::npos) {prefix = argument; continue;}
+      std::string key(argument.substr(0, equal)), value(argument.substr(equal + 1));
+      if      (key == "shells")  {shells  = size_t(std::stoul(value));}
+      else if (key == "steps")   {steps   = size_t(std::stoul(value));}
+      else if (key == "ribs")    {ribs    = size_t(std::stoul(value));}
+      else if (key == "method")  {method  = value;}
+      else if (key == "spacing") {spacing = std::stod(value);}
+      else if (key == "threads") {for (auto const & t : split(value)) {threads.push_back(size_t(std::stoul(t)));}}
+      else {ENVE_ERROR("enve_bench_02: unknown key '" + key + "'.");}
+    }
+    if (threads.empty())
+    {
+      for (size_t t = 1; t <= std::min(hardware, size_t(64)); t *= 2) {threads.push_back(t);}
+      if (threads.back() != std::min(hardware, size_t(64))) {threads.push_back(std::min(hardware, size_t(64)));}
+    }
+
+    // Shared road
+    ground::generator::parameters data;
+    data.length    = 100.0;
+    data.width     = 6.0;
+    data.spacing   = spacing;
+    data.roughness = 'C';
+    data.seed      = 3;
+    ground::generator road(data);
+    std::vector<ground::mesh::ptr> shared = {road.build()};
+    std::cout
+      << "Mesh triangles = " << shared[0]->size() << ", shells = " << shells << ", steps = " << steps
+      << ", ribs = " << ribs << ", method = " << method << ", hardware threads = " << hardware << std::endl
+      << std::endl;
+
+    // Speedups are measured against a single thread run, whatever the threads list
+    run(shared, shells, 1, steps / 10 + 1, ribs, method, false, data.length, data.width); // Warm-up
+    real base = run(shared, shells, 1, steps, ribs, method, false, data.length, data.width);
+    std::cout << "Single thread baseline = " << base << " steps/s" << std::endl << std::endl;
+
+    // Scaling with the shared mesh, with thread-allocated shells and with private meshes
+    std::ofstream file(prefix + ".csv");
+    file << "threads,steps_per_s,speedup,efficiency,local_shells_steps_per_s,private_mesh_steps_per_s,sharing_loss,false_sharing_loss" << std::endl;
+    std::cout
+      << std::setw(8) << "threads" << std::setw(14) << "steps/s" << std::setw(10) << "speedup" << std::setw(12) << "efficiency"
+      << std::setw(16) << "local [s^-1]" << std::setw(16) << "private [s^-1]" << std::setw(10) << "sharing" << std::setw(10) << "false sh." << std::endl;
+    for (size_t n = 0; n < threads.size(); ++n)
+    {
+      size_t t = std::min(threads[n], shells);
+      run(shared, shells, t, steps / 10 + 1, ribs, method, false, data.length, data.width); // Warm-up
+      real packed = run(shared, shells, t, steps, ribs, method, false, data.length, data.width);
+      real local  = run(shared, shells, t, steps, ribs, method, true, data.length, data.width);
+      std::vector<ground::mesh::ptr> copies(t);
+      for (size_t i = 0; i < t; ++i) {copies[i] = i == 0 ? shared[0] : road.build();}
+      real owned  = run(copies, shells, t, steps, ribs, method, true, data.length, data.width);
+      real speedup    = packed / base;
+      real efficiency = speedup / t;
+      real sharing    = owned / local - 1.0;  // Throughput gained without the shared mesh
+      real falsehood  = local / packed - 1.0; // Throughput gained with thread-allocated shells
+      file
+        << t << "," << packed << "," << speedup << "," << efficiency << "," << local << "," << owned << ","
+        << sharing << "," << falsehood << std::endl;
+      std::cout
+        << std::fixed << std::setw(8) << t << std::setprecision(0) << std::setw(14) << packed << std::setprecision(2)
+        << std::setw(10) << speedup << std::setw(12) << efficiency << std::setprecision(0) << std::setw(16) << local
+        << std::setw(16) << owned << std::setprecision(3) << std::setw(10) << sharing << std::setw(10) << falsehood << std::endl;
+      std::cout.unsetf(std::ios::floatfield);
+      std::cout << std::setprecision(6);
+    }
+    std::cout
+      << std::endl
+      << "sharing   : throughput gained with one private mesh per thread (memory bandwidth and cache sharing)" << std::endl
+      << "false sh. : throughput gained with shells allocated by their own thread (false sharing and placement)" << std::endl
+      << "Results written to " << prefix << ".csv" << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "BENCH 02: Completed" << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return 0;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_bench_02.cc
+///
@@ -0,0 +1,345 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_perf_00.cc
+///
+
+#include "enve.hh"
+
+#include <iomanip>
+
+using namespace acme;
+using namespace enve;
+
+// Benchmark case results
+struct measure
+{
+  std::string       name;    // Case name
+  std::vector<real> outputs; // Reference outputs (mean point, mean normal, mean and max depth)
+  std::vector<real> samples; // Timing samples normalized by the calibration time
+  real              median;  // Median timing sample (us)
+};
+
+// Median of a samples vector
+real
+median(
+  std::vector<real> samples
+)
+{
+  std::sort(samples.begin(), samples.end());
+  size_t n = samples.size();
+  return n % 2 == 1 ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+}
+
+// One-sided Mann-Whitney U test z-score (positive if the current samples are larger)
+real
+mannWhitney(
+  std::vector<real> const & baseline,
+  std::vector<real> const & current
+)
+{
+  real u = 0.0, n = real(current.size()), m = real(baseline.size());
+  for (size_t i = 0; i < current.size(); ++i)
+  {
+    for (size_t j = 0; j < baseline.size(); ++j)
+      {u += current[i] > baseline[j] ? 1.0 : (current[i] == baseline[j] ? 0.5 : 0.0);}
+  }
+  return (u - 0.5 * n * m) / std::sqrt(n * m * (n + m + 1.0) / 12.0);
+}
+
+// Fixed arithmetic workload time (us) used to normalize the timings across machines
+real
+calibration(void)
+{
+  std::vector<real> samples;
+  for (size_t r = 0; r < 11; ++r)
+  {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    mat3 a(angleaxis(0.1, vec3(1.0, 2.0, 3.0).normalized()).toRotationMatrix()), b(IDENTITY_MAT4.block<3,3>(0,0));
+    vec3 v(1.0, 0.0, 0.0);
+    for (size_t k = 0; k < 200000; ++k)
+    {
+      b = a * b;
+      v = b * v + vec3(0.0, 1.0e-9, 0.0);
+      v /= std::sqrt(v.dot(v));
+    }
+    real elapsed = std::chrono::duration<real, std::micro>(std::chrono::steady_clock::now() - start).count();
+    samples.push_back(v.x() > 2.0 ? 0.0 : elapsed);
+  }
+  return median(samples);
+}
+
+// Main function
+int
+main(
+  int          argc,
+  char const * argv[]
+)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "PERF 00 - ENVE PERFORMANCE REGRESSION" << std::endl
+      << std::endl;
+
+    // Options: baseline path, "--record" to store the baseline of this machine, thresholds
+    std::string path("./enve_perf_00.csv");
+    bool record = false;
+    real slowdown = 0.15, z_critical = 3.09, tolerance = 1.0e-4;
+    size_t retries = 2;
+    for (int k = 1; k < argc; ++k)
+    {
+      std::string argument(argv[k]);
+      if      (argument == "--record")                 {record     = true;}
+      else if (argument.compare(0, 9, "slowdown=") == 0)  {slowdown   = std::stod(argument.substr(9));}
+      else if (argument.compare(0, 2, "z=") == 0)         {z_critical = std::stod(argument.substr(2));}
+      else if (argument.compare(0, 10, "tolerance=") == 0) {tolerance  = std::stod(argument.substr(10));}
+      else if (argument.compare(0, 8, "retries=") == 0)   {retries    = size_t(std::stoul(argument.substr(8)));}
+      else                                              {path       = argument;}
+    }
+    size_t repeats = 11, steps = 100;
+    real calibration_time = calibration();
+
+    // Deterministic generated roads
+    std::vector<std::string> names = {"smooth", "rough"};
+    std::vector<ground::mesh::ptr> roads;
+    ground::generator::parameters data;
+    data.length  = 12.0;
+    data.width   = 3.0;
+    data.spacing = 0.05;
+    data.seed    = 11;
+    data.roughness = 'A';
+    ground::generator smooth(data);
+    roads.push_back(smooth.build());
+    data.roughness   = 'D';
+    data.kerb_height = 0.05;
+    data.potholes    = 6;
+    ground::generator rough(data);
+    roads.push_back(rough.build());
+
+    // Each case is a function measuring it against the current calibration time
+    std::vector<std::function<measure(real)>> cases;
+
+    // Mesh AABB tree build
+    cases.push_back([&](real calibration_time) {
+      measure m{"mesh_build", {}, {}, 0.0};
+      triangleground::vecptr triangles(rough.triangles());
+      std::vector<real> raw;
+      for (size_t r = 0; r < repeats; ++r)
+      {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        ground::mesh built(triangles);
+        raw.push_back(std::chrono::duration<real, std::micro>(std::chrono::steady_clock::now() - start).count());
+        if (r == 0)
+        {
+          aabb box(built.bbox());
+          m.outputs = {box.min().x(), box.min().y(), box.min().z(), box.max().x(), box.max().y(), box.max().z(), real(built.size())};
+        }
+      }
+      for (size_t r = 0; r < repeats; ++r) {m.samples.push_back(raw[r] / calibration_time);}
+      m.median = median(raw);
+      return m;
+    });
+
+    // Shell setups along fixed trajectories
+    std::string methods[2] = {"geometric", "sampling"};
+    size_t ribs[3] = {1, 10, 20};
+    for (size_t g = 0; g < roads.size(); ++g)
+    {
+      ground::generator const & road = g == 0 ? smooth : rough;
+      std::shared_ptr<std::vector<affine>> trajectory(new std::vector<affine>());
+      std::vector<affine> & poses = *trajectory;
+      for (size_t k = 0; k < steps; ++k)
+      {
+        real x = 1.0 + 10.0 * k / steps, y = 1.5 + 0.8 * std::sin(0.5 * x) + 0.0071;
+        poses.push_back(translate(x, y, road.height(x, y) + 0.307) * angleaxis(0.2 * std::sin(x), UNITZ_VEC3));
+      }
+      for (size_t mt = 0; mt < 2; ++mt)
+      {
+        for (size_t r = 0; r < 3; ++r)
+        {
+          cases.push_back([&, g, mt, r, trajectory](real calibration_time) {
+            std::vector<affine> const & poses = *trajectory;
+            measure m{names[g] + "_" + methods[mt] + "_" + std::to_string(ribs[r]), std::vector<real>(8, 0.0), {}, 0.0};
+            shell tire(ribs[r], 0.327, 4.0, 0.195, 4.0, 0.188);
+            std::vector<real> raw;
+            point contact_point;
+            vec3  contact_normal;
+            real  contact_depth;
+            for (size_t rep = 0; rep <= repeats; ++rep)
+            {
+              std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+              for (size_t k = 0; k < steps; ++k)
+              {
+                tire.setup(*roads[g], poses[k], methods[mt]);
+                tire.contactPoint(contact_point);
+                tire.contactNormal(contact_normal);
+                tire.contactDepth(contact_depth);
+                if (rep == 0)
+                {
+                  for (size_t j = 0; j < 3; ++j) {m.outputs[j] += contact_point[j] / steps; m.outputs[3 + j] += contact_normal[j] / steps;}
+                  m.outputs[6] += contact_depth / steps;
+                  m.outputs[7]  = std::max(m.outputs[7], contact_depth);
+                }
+              }
+              real elapsed = std::chrono::duration<real, std::micro>(std::chrono::steady_clock::now() - start).count() / steps;
+              if (rep > 0) {raw.push_back(elapsed);} // The first repetition is the warm-up
+            }
+            for (size_t i = 0; i < raw.size(); ++i) {m.samples.push_back(raw[i] / calibration_time);}
+            m.median = median(raw);
+            return m;
+          });
+        }
+      }
+    }
+    std::vector<measure> measures;
+    for (size_t i = 0; i < cases.size(); ++i)
+      {measures.push_back(cases[i](calibration_time));}
+
+    // Store the baseline
+    if (record)
+    {
+      std::ofstream file(path);
+      file.precision(17);
+      file << "case,median_us,outputs,samples" << std::endl;
+      for (size_t i = 0; i < measures.size(); ++i)
+      {
+        file << measures[i].name << "," << measures[i].median << ",";
+        for (size_t j = 0; j < measures[i].outputs.size(); ++j) {file << (j > 0 ? ";" : "") << measures[i].outputs[j];}
+        file << ",";
+        for (size_t j = 0; j < measures[i].samples.size(); ++j) {file << (j > 0 ? ";" : "") << measures[i].samples[j];}
+        file << std::endl;
+      }
+      std::cout
+        << "Baseline written to " << path << " (" << measures.size() << " cases)" << std::endl
+        << std::endl
+        << "PERF 00: Completed" << std::endl
+        << "---------------------------" << std::endl;
+      return file.good() ? 0 : 1;
+    }
+
+    // Load the baseline
+    std::ifstream file(path);
+    if (!file.is_open())
+      {ENVE_ERROR("enve_perf_00: missing baseline " + path + " (record it on this machine with the '--record' argument).");}
+    std::map<std::string, measure> baseline;
+    std::string line, cell, value;
+    std::getline(file, line);
+    while (std::getline(file, line))
+    {
+      std::stringstream row(line);
+      measure m;
+      std::getline(row, m.name, ',');
+      std::getline(row, cell, ',');
+      m.median = std::stod(cell);
+      for (size_t c = 0; c < 2; ++c)
+      {
+        std::getline(row, cell, ',');
+        std::stringstream values(cell);
+        while (std::getline(values, value, ';'))
+          {(c == 0 ? m.outputs : m.samples).push_back(std::stod(value));}
+      }
+      baseline[m.name] = m;
+    }
+
+    // Compare against the baseline
+    bool passed = true;
+    std::cout
+      << std::left << std::setw(22) << "case" << std::right << std::setw(13) << "base [us]" << std::setw(13) << "now [us]"
+      << std::setw(9) << "ratio" << std::setw(8) << "z" << "  status" << std::endl;
+    for (size_t i = 0; i < measures.size(); ++i)
+    {
+      measure const & now = measures[i];
+      std::map<std::string, measure>::const_iterator it = baseline.find(now.name);
+      if (it == baseline.end())
+      {
+        std::cout << std::left << std::setw(22) << now.name << "  missing from the baseline" << std::endl;
+        passed = false;
+        continue;
+      }
+      measure const & base = it->second;
+      bool same = base.outputs.size() == now.outputs.size();
+      for (size_t j = 0; same && j < now.outputs.size(); ++j)
+        {same = std::abs(now.outputs[j] - base.outputs[j]) <= tolerance * std::max(1.0, std::abs(base.outputs[j]));}
+      real ratio = median(now.samples) / median(base.samples);
+      real z     = mannWhitney(base.samples, now.samples);
+      bool slower = ratio > 1.0 + slowdown && z > z_critical;
+      size_t attempts = 1;
+      while (same && slower && attempts <= retries)
+      {
+        // Confirm the slowdown with a fresh calibration to reject transient host load
+        ++attempts;
+        measures[i] = cases[i](calibration());
+        ratio  = median(now.samples) / median(base.samples);
+        z      = mannWhitney(base.samples, now.samples);
+        slower = ratio > 1.0 + slowdown && z > z_critical;
+      }
+      passed = passed && same && !slower;
+      std::cout
+        << std::left << std::setw(22) << now.name << std::right << std::fixed << std::setprecision(1)
+        << std::setw(13) << base.median << std::setw(13) << now.median << std::setprecision(3)
+        << std::setw(9) << ratio << std::setprecision(2) << std::setw(8) << z
+        << "  " << (!same ? "OUTPUT DEVIATION" : (slower ? "SLOWDOWN" : "ok"))
+        << (attempts > 1 ? " (attempt " + std::to_string(attempts) + ")" : "") << std::endl;
+      std::cout.unsetf(std::ios::floatfield);
+    }
+
+    // End of test
+    std::cout
+      << std::endl
+      << "PERF 00: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_perf_00.cc
+///
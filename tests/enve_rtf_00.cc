@@ -97,7 +97,6 @@ main(void)
     // Perform timing
     triangleground::vecptr triangles_list;
     real triangles_list_size = 0.0;
-    real variance = 0.0;
     size_t times = 1000;
     vecN   times_tmp(times);
     for (size_t ii = 0; ii < tire_max_ribs; ++ii) {
@@ -124,22 +123,21 @@ main(void)
           tictoc.toc();
 
           // Update single disk timing
-
           times_tmp[kk] = tictoc.elapsed_ms();
 
-          // Update common variables
-          time_mat(ii,jj) = times_tmp.mean();
-          var_mat(ii,jj) = 0.0;
-          for (integer i = 0; i < times_tmp.size(); ++i)
-            {var_mat(ii,jj) += (times_tmp[kk] - time_mat(ii,jj)) * (times_tmp[kk] - time_mat(ii,jj));}
-          var_mat(ii,jj) /= times_tmp.size();
-          std_mat(ii,jj) = std::sqrt(var_mat(ii,jj));
-
           // Update common variables
           road[jj].intersection(tire.bbox(), triangles_list);
           triangles_list_size += triangles_list.size();
           triangles_list.clear();
         }
+
+        // Update timing statistics
+        time_mat(ii,jj) = times_tmp.mean();
+        var_mat(ii,jj) = 0.0;
+        for (integer i = 0; i < times_tmp.size(); ++i)
+          {var_mat(ii,jj) += (times_tmp[i] - time_mat(ii,jj)) * (times_tmp[i] - time_mat(ii,jj));}
+        var_mat(ii,jj) /= times_tmp.size();
+        std_mat(ii,jj) = std::sqrt(var_mat(ii,jj));
       }
     }
 
@@ -0,0 +1,347 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_rtf_01.cc
+///
+
+#include "enve.hh"
+
+#include <iomanip>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace acme;
+using namespace enve;
+
+// Log-linear latency histogram (HDR-style, exact below 128 ns, then 64 sub-buckets per power of two)
+class histogram
+{
+  std::vector<std::uint64_t> m_counts; // Bucket counts
+  std::uint64_t              m_total;  // Recorded values
+  std::uint64_t              m_max;    // Largest recorded value (ns)
+  real                       m_sum;    // Recorded values sum (ns)
+  real                       m_sum2;   // Recorded values squares sum (ns^2)
+
+public:
+  histogram(void) : m_counts(64 * 64, 0), m_total(0), m_max(0), m_sum(0.0), m_sum2(0.0) {}
+
+  static size_t index(std::uint64_t v)
+  {
+    if (v < 128) {return size_t(v);}
+    size_t shift = 0;
+    while ((v >> shift) >= 128) {++shift;}
+    return (shift + 1) * 64 + size_t(v >> shift) - 64;
+  }
+
+  static std::uint64_t lower(size_t i)
+  {
+    if (i < 128) {return i;}
+    size_t shift = i / 64 - 1;
+    return std::uint64_t(i % 64 + 64) << shift;
+  }
+
+  static std::uint64_t upper(size_t i) {return i < 128 ? i + 1 : lower(i) + (std::uint64_t(1) << (i / 64 - 1));}
+
+  void record(std::uint64_t v)
+  {
+    ++m_counts[std::min(index(v), m_counts.size() - 1)];
+    ++m_total;
+    m_max   = std::max(m_max, v);
+    m_sum  += real(v);
+    m_sum2 += real(v) * real(v);
+  }
+
+  std::uint64_t total(void) const {return m_total;}
+  std::uint64_t max(void) const {return m_max;}
+  std::uint64_t count(size_t i) const {return m_counts[i];}
+  size_t size(void) const {return m_counts.size();}
+  real mean(void) const {return m_total > 0 ? m_sum / m_total : 0.0;}
+  real stddev(void) const {return m_total > 0 ? std::sqrt(std::max(0.0, m_sum2 / m_total - mean() * mean())) : 0.0;}
+
+  // Highest value equivalent to the q-quantile (bucket upper bound, capped at the maximum)
+  std::uint64_t percentile(real q) const
+  {
+    std::uint64_t rank = std::max(std::uint64_t(1), std::uint64_t(std::ceil(q * m_total))), sum = 0;
+    for (size_t i = 0; i < m_counts.size(); ++i)
+    {
+      sum += m_counts[i];
+      if (sum >= rank) {return std::min(upper(i) - 1, m_max);}
+    }
+    return m_max;
+  }
+};
+
+// Harness configuration
+struct configuration
+{
+  size_t      shells;  // Shells evaluated per step
+  size_t      ribs;    // Ribs per shell
+  std::string method;  // Enveloping method
+  real        spacing; // Road grid spacing (m)
+  real        rate;    // Step rate (Hz)
+};
+
+// Split a comma separated list
+std::vector<std::string>
+split(
+  std::string const & value
+)
+{
+  std::vector<std::string> items;
+  std::stringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ','))
+    {items.push_back(item);}
+  return items;
+}
+
+// Pin the calling thread to a CPU and/or raise it to SCHED_FIFO (false if not granted)
+bool
+realtime(
+  int cpu,
+  int priority
+)
+{
+#ifdef __linux__
+  bool granted = true;
+  if (cpu >= 0)
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    granted = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0 && granted;
+  }
+  if (priority > 0)
+  {
+    sched_param param;
+    param.sched_priority = priority;
+    granted = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0 && granted;
+  }
+  return granted;
+#else
+  return cpu < 0 && priority <= 0;
+#endif
+}
+
+// Main function
+int
+main(
+  int          argc,
+  char const * argv[]
+)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "RTF 01 - ENVE REAL-TIME FACTOR AND TAIL LATENCY" << std::endl
+      << std::endl;
+
+    // Parse the harness options (key=value, lists comma separated)
+    std::string prefix("./enve_rtf_01");
+    std::vector<std::string> shells = {"1", "4"}, ribs = {"10"}, methods = {"geometric", "sampling"},
+                             spacings = {"0.1", "0.02"}, rates = {"1000"};
+    size_t steps = 2000;
+    int    cpu = -1, priority = 0;
+    for (int k = 1; k < argc; ++k)
+    {
+      std::string argument(argv[k]);
+      size_t equal = argument.find('=');
+      if (equal == std::string::npos) {prefix = argument; continue;}
+      std::string key(argument.substr(0, equal)), value(argument.substr(equal + 1));
+      if      (key == "shells")  {shells   = split(value);}
+      else if (key == "ribs")    {ribs     = split(value);}
+      else if (key == "method")  {methods  = split(value);}
+      else if (key == "spacing") {spacings = split(value);}
+      else if (key == "rate")    {rates    = split(value);}
+      else if (key == "steps")   {steps    = size_t(std::stoul(value));}
+      else if (key == "pin")     {cpu      = std::stoi(value);}
+      else if (key == "fifo")    {priority = std::stoi(value);}
+      else {ENVE_ERROR("enve_rtf_01: unknown key '" + key + "'.");}
+    }
+    if (cpu >= 0 || priority > 0)
+    {
+      bool granted = realtime(cpu, priority);
+      std::cout << "Pinning/SCHED_FIFO: " << (granted ? "granted" : "not granted, running best effort") << std::endl;
+    }
+
+    // Configurations grid
+    std::vector<configuration> configurations;
+    for (auto const & s : shells)
+      for (auto const & r : ribs)
+        for (auto const & m : methods)
+          for (auto const & d : spacings)
+            for (auto const & f : rates)
+              {configurations.push_back({std::stoul(s), std::stoul(r), m, std::stod(d), std::stod(f)});}
+
+    std::ofstream summary(prefix + ".csv");
+    std::ofstream buckets(prefix + "_histogram.csv");
+    summary
+      << "config,shells,ribs,method,spacing_m,triangles,rate_hz,steps,mean_us,stddev_us,p50_us,p99_us,p999_us,max_us,"
+      << "wakeup_p99_us,wakeup_max_us,overruns,rtf_mean,rtf_p99,rtf_max" << std::endl;
+    buckets << "config,lower_us,upper_us,count,cumulative" << std::endl;
+    std::cout
+      << std::setw(4) << "cfg" << std::setw(7) << "shells" << std::setw(6) << "ribs" << std::setw(10) << "method"
+      << std::setw(8) << "spacing" << std::setw(8) << "rate" << std::setw(10) << "p50[us]" << std::setw(10) << "p99[us]"
+      << std::setw(10) << "p99.9[us]" << std::setw(10) << "max[us]" << std::setw(10) << "jit[us]" << std::setw(8) << "overrun"
+      << std::setw(9) << "RTF" << std::endl;
+
+    ground::mesh::ptr road;
+    real road_spacing = 0.0;
+    for (size_t c = 0; c < configurations.size(); ++c)
+    {
+      configuration const & config = configurations[c];
+
+      // Generated road for the configuration density
+      if (!road || road_spacing != config.spacing)
+      {
+        ground::generator::parameters data;
+        data.length    = 40.0;
+        data.width     = 4.0;
+        data.spacing   = config.spacing;
+        data.roughness = 'C';
+        data.seed      = 1;
+        road = ground::generator(data).build();
+        road_spacing = config.spacing;
+      }
+
+      // Shells spread over the road like vehicle axles
+      std::vector<std::unique_ptr<shell>> tires;
+      for (size_t s = 0; s < config.shells; ++s)
+        {tires.emplace_back(new shell(config.ribs, 0.327, 4.0, 0.195, 4.0, 0.188));}
+
+      // Paced steps at the configuration rate
+      typedef std::chrono::steady_clock clock;
+      clock::duration period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<real>(1.0 / config.rate));
+      real dt = 1.0 / config.rate, speed = 20.0, x = 0.0;
+      histogram latency, wakeup;
+      size_t overruns = 0, warmup = steps / 10;
+      point contact_point;
+      vec3  contact_normal, relative_angles;
+      real  friction, depth;
+      clock::time_point tick = clock::now();
+      for (size_t k = 0; k < warmup + steps; ++k)
+      {
+        tick += period;
+        std::this_thread::sleep_until(tick);
+        clock::time_point start = clock::now();
+        for (size_t s = 0; s < config.shells; ++s)
+        {
+          real x_s = 1.0 + std::fmod(x + 3.0 * (s / 2), 36.0), y_s = s % 2 == 0 ? 1.0 : 3.0;
+          tires[s]->setup(*road, affine(translate(x_s, y_s, 0.3)), config.method);
+          tires[s]->contactPoint(contact_point);
+          tires[s]->contactNormal(contact_normal);
+          tires[s]->contactFriction(friction);
+          tires[s]->contactDepth(depth);
+          tires[s]->relativeAngles(relative_angles);
+        }
+        clock::time_point stop = clock::now();
+        x += speed * dt;
+        if (k < warmup) {continue;}
+        std::uint64_t elapsed = std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+        latency.record(elapsed);
+        wakeup.record(std::uint64_t(std::max(std::int64_t(0), std::int64_t(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(start - tick).count()))));
+        if (stop - tick > period)
+        {
+          ++overruns;
+          tick = stop - period; // Restart the schedule instead of bursting
+        }
+      }
+
+      // Report
+      real dt_ns = 1.0e9 * dt;
+      summary
+        << c << "," << config.shells << "," << config.ribs << "," << config.method << "," << config.spacing << ","
+        << road->size() << "," << config.rate << "," << steps << ","
+        << latency.mean() / 1.0e3 << "," << latency.stddev() / 1.0e3 << ","
+        << latency.percentile(0.5) / 1.0e3 << "," << latency.percentile(0.99) / 1.0e3 << ","
+        << latency.percentile(0.999) / 1.0e3 << "," << latency.max() / 1.0e3 << ","
+        << wakeup.percentile(0.99) / 1.0e3 << "," << wakeup.max() / 1.0e3 << "," << overruns << ","
+        << latency.mean() / dt_ns << "," << latency.percentile(0.99) / dt_ns << "," << latency.max() / dt_ns << std::endl;
+      std::uint64_t cumulative = 0;
+      for (size_t i = 0; i < latency.size(); ++i)
+      {
+        if (latency.count(i) == 0) {continue;}
+        cumulative += latency.count(i);
+        buckets
+          << c << "," << histogram::lower(i) / 1.0e3 << "," << histogram::upper(i) / 1.0e3 << ","
+          << latency.count(i) << "," << real(cumulative) / latency.total() << std::endl;
+      }
+      std::cout
+        << std::fixed << std::setprecision(1)
+        << std::setw(4) << c << std::setw(7) << config.shells << std::setw(6) << config.ribs << std::setw(10) << config.method
+        << std::setprecision(3) << std::setw(8) << config.spacing << std::setprecision(0) << std::setw(8) << config.rate
+        << std::setprecision(1)
+        << std::setw(10) << latency.percentile(0.5) / 1.0e3 << std::setw(10) << latency.percentile(0.99) / 1.0e3
+        << std::setw(10) << latency.percentile(0.999) / 1.0e3 << std::setw(10) << latency.max() / 1.0e3
+        << std::setw(10) << wakeup.percentile(0.99) / 1.0e3 << std::setw(8) << overruns
+        << std::setprecision(3) << std::setw(9) << latency.mean() / dt_ns << std::endl;
+      std::cout.unsetf(std::ios::fixed);
+      std::cout << std::setprecision(6);
+    }
+    std::cout
+      << std::endl
+      << "Results written to " << prefix << ".csv and " << prefix << "_histogram.csv" << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "RTF 01: Completed" << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return 0;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_rtf_01.cc
+///
@@ -0,0 +1,189 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_07.cc
+///
+
+#include "enve.hh"
+
+#include <iomanip>
+
+using namespace acme;
+using namespace enve;
+
+// Contact results of all the ribs as [point normal depth] per rib
+std::vector<real>
+results(
+  ground::mesh const & road,
+  affine       const & pose,
+  size_t               ribs,
+  std::string  const   method
+)
+{
+  shell tire_shell(ribs, 0.327, 4.0, 0.195, 4.0, 0.188);
+  tire_shell.setup(road, pose, method);
+  std::vector<real> out;
+  point contact_point;
+  vec3  contact_normal;
+  real  contact_depth;
+  for (size_t i = 0; i < ribs; ++i)
+  {
+    tire_shell.contactPoint(i, contact_point);
+    tire_shell.contactNormal(i, contact_normal);
+    tire_shell.contactDepth(i, contact_depth);
+    out.insert(out.end(), {contact_point.x(), contact_point.y(), contact_point.z(),
+                           contact_normal.x(), contact_normal.y(), contact_normal.z(), contact_depth});
+  }
+  return out;
+}
+
+// Main function
+int
+main(
+  int          argc,
+  char const * argv[]
+)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 07 - ENVE SINGLE PRECISION DEVIATION" << std::endl
+      << std::endl;
+
+    // Golden results recorded by a double precision build with the "--record" argument
+    std::string path("./files_golden/enve_test_07.csv");
+    bool record = argc > 1 && std::string(argv[1]) == "--record";
+#ifdef ENVE_SINGLE_PRECISION
+    ENVE_ASSERT(!record, "enve_test_07: golden results must be recorded by a double precision build.");
+#endif
+
+    // Maximum allowed deviation from the double precision results (m)
+    real tolerance = 1.0e-4;
+
+    // Load the test grounds, the last one is moved kilometres away from the origin
+    affine offset;
+    offset = translate(8192.3, 16384.7, 0.0);
+    ground::mesh rdf("./files_rdf/sample.rdf");
+    ground::mesh obj("./files_obj/sample.obj", 1.0);
+    ground::mesh far("./files_rdf/sample.rdf", offset);
+
+    // Scenarios from enve_test_00 and enve_test_06, plus the first one far
+    // from the origin where single precision rounding is not negligible
+    affine pose_rdf, pose_obj, pose_far;
+    pose_rdf = translate(2.0, 5.0, 0.25);
+    pose_obj = translate(0.25, 0.25, 0.28);
+    pose_far = offset * pose_rdf;
+
+    std::vector<std::vector<real>> current;
+    std::vector<std::string> methods = {"geometric", "sampling"};
+    for (size_t i = 0; i < methods.size(); ++i)
+    {
+      current.push_back(results(rdf, pose_rdf, 20, methods[i]));
+      current.push_back(results(obj, pose_obj, 3,  methods[i]));
+      current.push_back(results(far, pose_far, 20, methods[i]));
+    }
+
+    // Store the golden results
+    if (record)
+    {
+      std::ofstream file(path);
+      file.precision(17);
+      for (size_t i = 0; i < current.size(); ++i)
+      {
+        for (size_t j = 0; j < current[i].size(); ++j)
+          {file << (j > 0 ? "," : "") << current[i][j];}
+        file << std::endl;
+      }
+      std::cout
+        << "Golden results written to " << path << std::endl
+        << std::endl
+        << "TEST 07: " << (file.good() ? "Completed" : "Failed") << std::endl
+        << "---------------------------" << std::endl;
+      return file.good() ? 0 : 1;
+    }
+
+    // Load the golden results
+    std::ifstream file(path);
+    ENVE_ASSERT(file.is_open(), "enve_test_07: missing golden results " + path + ".");
+    std::vector<std::vector<real>> golden;
+    std::string line, value;
+    while (std::getline(file, line))
+    {
+      std::stringstream row(line);
+      golden.push_back(std::vector<real>());
+      while (std::getline(row, value, ','))
+        {golden.back().push_back(std::stod(value));}
+    }
+
+    // Check the results
+    bool passed = golden.size() == current.size();
+    std::cout << "Storage precision = " << (sizeof(real_storage) == sizeof(float) ? "single" : "double") << std::endl;
+    for (size_t i = 0; passed && i < current.size(); ++i)
+    {
+      real error = 0.0;
+      passed = passed && golden[i].size() == current[i].size();
+      for (size_t j = 0; passed && j < current[i].size(); ++j)
+        {error = std::max(error, std::abs(current[i][j] - golden[i][j]));}
+      std::cout << "Scenario " << i << " - max deviation = " << error << std::endl;
+      passed = passed && error < tolerance;
+    }
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 07: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_07.cc
+///
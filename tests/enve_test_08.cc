@@ -0,0 +1,185 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_08.cc
+///
+
+#include "enve.hh"
+#include "TicToc.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 08 - ENVE WARM-STARTED MESH INTERSECTION" << std::endl
+      << std::endl;
+
+    // Instantiate a TicToc object
+    TicToc tictoc;
+
+    // Generate a rough road with a friction patch
+    ground::generator::parameters data;
+    data.length    = 10.0;
+    data.width     = 3.0;
+    data.spacing   = 0.05;
+    data.roughness = 'B';
+    data.patches   = {{3.0, 6.0, 0.0, 1.5, 0.8}};
+    ground::generator      generated(data);
+    triangleground::vecptr triangles(generated.triangles());
+
+    // Add a plank not edge-connected to the road (the walk must not miss it)
+    real  z = generated.height(4.1, 1.5) + 0.02;
+    point p0(4.0, 1.0, z), p1(4.2, 1.0, z), p2(4.2, 2.0, z), p3(4.0, 2.0, z);
+    triangles.push_back(std::make_shared<triangleground const>(triangles.size(), 1.0, p0, p1, p2));
+    triangles.push_back(std::make_shared<triangleground const>(triangles.size(), 1.0, p0, p2, p3));
+    ground::mesh road(triangles);
+
+    // Count the boxes tested by an AABB tree query
+    auto queried = [&road](aabb const & box) -> size_t {
+      std::vector<bvh::node> const & tree = road.AABBtree().nodes();
+      size_t count = 0;
+      std::vector<std::uint32_t> stack(1, 0);
+      while (!stack.empty())
+      {
+        bvh::node const & n = tree[stack.back()];
+        stack.pop_back();
+        ++count;
+        aabb node_box(n.box[0], n.box[1], n.box[2], n.box[3], n.box[4], n.box[5]);
+        if (!node_box.intersects(box))
+          {continue;}
+        if (n.count == 0)
+          {stack.push_back(n.first); stack.push_back(n.first + 1);}
+        else
+          {count += n.count;}
+      }
+      return count;
+    };
+
+    // Initialize the tire shells
+    shell cold_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    shell warm_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    warm_shell.warmStart(true);
+
+    // Roll the shells along the mesh
+    size_t steps = 500;
+    real   error = 0.0;
+    real   time_cold = 0.0, time_warm = 0.0;
+    size_t walks = 0, visited = 0, tested = 0;
+    affine pose;
+    point  point_cold, point_warm;
+    vec3   normal_cold, normal_warm;
+    real   depth_cold, depth_warm;
+    std::vector<std::string> methods = {"geometric", "sampling"};
+    for (size_t m = 0; m < methods.size(); ++m)
+    {
+      for (size_t k = 0; k < steps; ++k)
+      {
+        pose = translate(1.0 + 7.0 * k / steps, 1.5, 0.3) * angleaxis(0.1, UNITZ_VEC3);
+
+        tictoc.tic();
+        cold_shell.setup(road, pose, methods[m]);
+        tictoc.toc();
+        time_cold += tictoc.elapsed_ms();
+
+        tictoc.tic();
+        warm_shell.setup(road, pose, methods[m]);
+        tictoc.toc();
+        time_warm += tictoc.elapsed_ms();
+
+        if (warm_shell.walked() > 0)
+        {
+          ++walks;
+          visited += warm_shell.walked();
+          tested  += queried(*warm_shell.bbox());
+        }
+
+        for (size_t i = 0; i < cold_shell.size(); ++i)
+        {
+          cold_shell.contactPoint(i, point_cold);
+          warm_shell.contactPoint(i, point_warm);
+          cold_shell.contactNormal(i, normal_cold);
+          warm_shell.contactNormal(i, normal_warm);
+          cold_shell.contactDepth(i, depth_cold);
+          warm_shell.contactDepth(i, depth_warm);
+          error = std::max(error, (point_cold - point_warm).norm());
+          error = std::max(error, (normal_cold - normal_warm).norm());
+          error = std::max(error, std::abs(depth_cold - depth_warm));
+        }
+      }
+    }
+    bool passed = error < EPSILON_ENVE && walks > 0 && visited < tested;
+
+    // Output performance data
+    std::cout
+      << "Max deviation  = " << error << std::endl
+      << "AABB tree time = " << time_cold << " ms" << std::endl
+      << "Walk time      = " << time_warm << " ms" << std::endl
+      << "Walks          = " << walks << " / " << methods.size() * steps << std::endl
+      << "Walk visits    = " << visited << " triangles" << std::endl
+      << "AABB tree cost = " << tested << " nodes and triangles" << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 08: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_08.cc
+///
@@ -0,0 +1,262 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_09.cc
+///
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "enve.hh"
+#include "TicToc.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Heap allocations counter
+static std::atomic<size_t> allocations(0);
+
+// Deallocation through an opaque pointer, so that the compiler does not pair
+// the inlined replaced operator new with a plain free()
+static void (* volatile deallocate)(void *) = std::free;
+
+// Counted allocation shared by all the replaced allocation functions
+void *
+allocate(
+  std::size_t size
+)
+{
+  ++allocations;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void *
+operator new(
+  std::size_t size
+)
+{
+  void * ptr = allocate(size);
+  if (ptr == nullptr)
+    {throw std::bad_alloc();}
+  return ptr;
+}
+
+void *
+operator new[](
+  std::size_t size
+)
+{
+  void * ptr = allocate(size);
+  if (ptr == nullptr)
+    {throw std::bad_alloc();}
+  return ptr;
+}
+
+void *
+operator new(
+  std::size_t size,
+  std::nothrow_t const &
+) noexcept
+{
+  return allocate(size);
+}
+
+void *
+operator new[](
+  std::size_t size,
+  std::nothrow_t const &
+) noexcept
+{
+  return allocate(size);
+}
+
+void
+operator delete(
+  void * ptr
+) noexcept
+{
+  deallocate(ptr);
+}
+
+void
+operator delete[](
+  void * ptr
+) noexcept
+{
+  deallocate(ptr);
+}
+
+void
+operator delete(
+  void * ptr,
+  std::size_t
+) noexcept
+{
+  deallocate(ptr);
+}
+
+void
+operator delete[](
+  void * ptr,
+  std::size_t
+) noexcept
+{
+  deallocate(ptr);
+}
+
+void
+operator delete(
+  void * ptr,
+  std::nothrow_t const &
+) noexcept
+{
+  deallocate(ptr);
+}
+
+void
+operator delete[](
+  void * ptr,
+  std::nothrow_t const &
+) noexcept
+{
+  deallocate(ptr);
+}
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 09 - ENVE STEADY-STATE SETUP ALLOCATIONS" << std::endl
+      << std::endl;
+
+    // Generate a rough road
+    ground::generator::parameters data;
+    data.length    = 5.0;
+    data.width     = 2.0;
+    data.roughness = 'B';
+    ground::mesh::ptr road(ground::generator(data).build());
+
+    // Check each enveloping method with and without warm start
+    bool passed = true;
+    std::vector<std::string> methods = {"geometric", "sampling"};
+    for (size_t m = 0; m < methods.size(); ++m)
+    {
+      for (size_t w = 0; w < 2; ++w)
+      {
+        shell tire_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+        tire_shell.warmStart(w == 1);
+
+        // Warm up the shell scratch buffers
+        affine pose;
+        size_t steps = 200;
+        for (size_t k = 0; k < steps; ++k)
+        {
+          pose = translate(1.0 + 2.0 * k / steps, 1.0, 0.3);
+          tire_shell.setup(*road, pose, methods[m]);
+        }
+
+        // Count the allocations on the same trajectory
+        size_t start = allocations;
+        for (size_t k = 0; k < steps; ++k)
+        {
+          pose = translate(1.0 + 2.0 * k / steps, 1.0, 0.3);
+          tire_shell.setup(*road, pose, methods[m]);
+        }
+        size_t count = allocations - start;
+        passed = passed && count == 0;
+
+        std::cout
+          << "Method = " << methods[m] << ", warm start = " << w
+          << " - allocations = " << count << std::endl;
+      }
+    }
+
+    // Check each enveloping method on the compressed road (decoding included)
+    ground::compressed packed(*road);
+    for (size_t m = 0; m < methods.size(); ++m)
+    {
+      shell tire_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+      affine pose;
+      size_t steps = 200;
+      for (size_t k = 0; k < steps; ++k)
+      {
+        pose = translate(1.0 + 2.0 * k / steps, 1.0, 0.3);
+        tire_shell.setup(packed, pose, methods[m]);
+      }
+      size_t start = allocations;
+      for (size_t k = 0; k < steps; ++k)
+      {
+        pose = translate(1.0 + 2.0 * k / steps, 1.0, 0.3);
+        tire_shell.setup(packed, pose, methods[m]);
+      }
+      size_t count = allocations - start;
+      passed = passed && count == 0;
+
+      std::cout
+        << "Method = " << methods[m] << ", compressed"
+        << " - allocations = " << count << std::endl;
+    }
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 09: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_09.cc
+///
@@ -0,0 +1,166 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_10.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 10 - ENVE BUDGETED SHELL SETUP" << std::endl
+      << std::endl;
+
+    // Generate a rough road with a friction patch
+    ground::generator::parameters data;
+    data.length    = 10.0;
+    data.width     = 3.0;
+    data.roughness = 'B';
+    data.patches   = {{3.0, 6.0, 0.0, 1.5, 0.8}};
+    ground::mesh::ptr road(ground::generator(data).build());
+
+    // Initialize the tire shells
+    shell plain_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    shell budget_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+
+    // Unlimited budget must match the plain setup
+    size_t steps = 200;
+    real   error = 0.0;
+    affine pose;
+    point  point_plain, point_budget;
+    vec3   normal_plain, normal_budget;
+    real   depth_plain, depth_budget;
+    budget unlimited;
+    report info;
+    bool   passed = true;
+    for (size_t k = 0; k < steps; ++k)
+    {
+      pose = translate(1.0 + 7.0 * k / steps, 1.5, 0.3) * angleaxis(0.1, UNITZ_VEC3);
+      plain_shell.setup(*road, pose, "geometric");
+      budget_shell.setup(*road, pose, "geometric", unlimited, info);
+      passed = passed && info.level == degradation::none && info.ribs == budget_shell.size() &&
+               info.tests >= info.local && info.search <= info.time;
+      for (size_t i = 0; i < plain_shell.size(); ++i)
+      {
+        plain_shell.contactPoint(i, point_plain);
+        budget_shell.contactPoint(i, point_budget);
+        plain_shell.contactNormal(i, normal_plain);
+        budget_shell.contactNormal(i, normal_budget);
+        plain_shell.contactDepth(i, depth_plain);
+        budget_shell.contactDepth(i, depth_budget);
+        error = std::max(error, (point_plain - point_budget).norm());
+        error = std::max(error, (normal_plain - normal_budget).norm());
+        error = std::max(error, std::abs(depth_plain - depth_budget));
+      }
+    }
+    passed = passed && error < EPSILON_ENVE;
+
+    // Tight budget degrades to interpolated ribs
+    budget tight;
+    tight.tests = info.local + (info.tests - info.local) / 3;
+    budget_shell.setup(*road, pose, "geometric", tight, info);
+    bool interpolated = info.level == degradation::ribs && info.tests <= tight.tests &&
+                        info.ribs > 0 && info.ribs < budget_shell.size();
+    real depth_error = 0.0;
+    for (size_t i = 0; i < plain_shell.size(); ++i)
+    {
+      plain_shell.contactDepth(i, depth_plain);
+      budget_shell.contactDepth(i, depth_budget);
+      depth_error = std::max(depth_error, std::abs(depth_plain - depth_budget));
+    }
+
+    // Empty budget extrapolates the last step results
+    budget empty;
+    empty.tests = 0;
+    affine next(translate(0.01, 0.0, 0.0) * pose);
+    point  point_last;
+    budget_shell.contactPoint(5, point_last);
+    budget_shell.setup(*road, next, "geometric", empty, info);
+    budget_shell.contactPoint(5, point_budget);
+    bool extrapolated = info.level == degradation::extrapolation && info.ribs == 0 &&
+                        (point_budget - point_last - vec3(0.01, 0.0, 0.0)).norm() < EPSILON_ENVE;
+
+    // Budget spent by the candidates search extrapolates too
+    budget_shell.setup(*road, next, "geometric", unlimited, info);
+    budget searched;
+    searched.tests = info.local;
+    budget_shell.setup(*road, next, "geometric", searched, info);
+    bool charged = info.level == degradation::extrapolation && info.ribs == 0 &&
+                   info.local > 0 && info.tests == info.local;
+    passed = passed && interpolated && extrapolated && charged;
+
+    // Output degradation data
+    std::cout
+      << "Max deviation (unlimited)    = " << error << std::endl
+      << "Max depth error (tight)      = " << depth_error << std::endl
+      << "Interpolated ribs level      = " << (interpolated ? "ok" : "wrong") << std::endl
+      << "Extrapolated step level      = " << (extrapolated ? "ok" : "wrong") << std::endl
+      << "Charged candidates search    = " << (charged ? "ok" : "wrong") << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 10: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_10.cc
+///
@@ -0,0 +1,131 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_11.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 11 - ENVE ASYNCHRONOUS MESH LOADING" << std::endl
+      << std::endl;
+
+    // Start loading the mesh in background
+    ground::mesh::future road_async = ground::mesh::loadAsync("./files_rdf/sample.rdf");
+    ground::flat         backup(1.0, point(0.0, 0.0, 0.0), UNITZ_VEC3);
+
+    // Initialize the tire shell
+    shell tire_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    affine pose(translate(1.0, 1.0, 0.2));
+
+    // Step on the back-up plane until the mesh is loaded
+    size_t flat_steps = 0;
+    bool   in_mesh    = false;
+    while (!in_mesh && flat_steps < 1000000)
+    {
+      in_mesh = tire_shell.setup(road_async, backup, pose, "geometric");
+      if (!in_mesh)
+        {++flat_steps;}
+    }
+    bool passed = in_mesh && ground::mesh::isReady(road_async);
+
+    // Compare with the mesh loaded in the main thread
+    ground::mesh road("./files_rdf/sample.rdf");
+    shell ref_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    ref_shell.setup(road, pose, "geometric");
+    real  error = 0.0, depth_ref, depth_async;
+    point point_ref, point_async;
+    for (size_t i = 0; i < ref_shell.size(); ++i)
+    {
+      ref_shell.contactPoint(i, point_ref);
+      tire_shell.contactPoint(i, point_async);
+      ref_shell.contactDepth(i, depth_ref);
+      tire_shell.contactDepth(i, depth_async);
+      error = std::max(error, (point_ref - point_async).norm());
+      error = std::max(error, std::abs(depth_ref - depth_async));
+    }
+    passed = passed && error < EPSILON_ENVE;
+
+    // Loading errors are rethrown by the future
+    bool rethrown = false;
+    ground::mesh::future wrong_async = ground::mesh::loadAsync("./files_rdf/missing.rdf");
+    try
+      {wrong_async.get();}
+    catch (std::exception const &)
+      {rethrown = true;}
+    passed = passed && rethrown;
+
+    // Output loading data
+    std::cout
+      << "Steps on back-up plane = " << flat_steps << std::endl
+      << "Max deviation          = " << error << std::endl
+      << "Loading error rethrown = " << (rethrown ? "yes" : "no") << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 11: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_11.cc
+///
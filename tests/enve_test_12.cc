@@ -0,0 +1,180 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_12.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Compare the contact depths of two shells
+real
+depthError(
+  shell const & shell_1,
+  shell const & shell_2
+)
+{
+  real error = 0.0, depth_1, depth_2;
+  for (size_t i = 0; i < shell_1.size(); ++i)
+  {
+    shell_1.contactDepth(i, depth_1);
+    shell_2.contactDepth(i, depth_2);
+    error = std::max(error, std::abs(depth_1 - depth_2));
+  }
+  return error;
+}
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 12 - ENVE HOT-SWAPPABLE MESH CONTAINER" << std::endl
+      << std::endl;
+
+    // Generate a rough banked road (distinct from the back-up plane)
+    ground::generator::parameters data;
+    data.length    = 2.0;
+    data.width     = 2.0;
+    data.roughness = 'B';
+    data.banking   = 0.05;
+    triangleground::vecptr triangles(ground::generator(data).triangles());
+    ground::mesh::ptr      grid(std::make_shared<ground::mesh const>(triangles));
+    ground::mesh           road("./files_rdf/sample.rdf");
+    ground::flat           backup(1.0, point(0.0, 0.0, 0.0), UNITZ_VEC3);
+
+    // Initialize the tire shells
+    shell tire_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    shell ref_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    tire_shell.warmStart(true);
+    affine pose(translate(1.0, 1.0, 0.2));
+
+    // Empty container uses the back-up plane
+    ground::container live;
+    bool passed = !tire_shell.setup(live, backup, pose, "geometric") && live.version() == 0;
+    ref_shell.setup(backup, pose, "geometric");
+    passed = passed && depthError(tire_shell, ref_shell) < EPSILON_ENVE;
+
+    // Published mesh is used at the next setup
+    live.publish(grid);
+    passed = passed && tire_shell.setup(live, backup, pose, "geometric") && live.version() == 1;
+    ref_shell.setup(*grid, pose, "geometric");
+    passed = passed && depthError(tire_shell, ref_shell) < EPSILON_ENVE;
+
+    // Replacement mesh loaded in background while the simulation keeps stepping
+    ground::mesh::ptr snapshot(live.get());
+    live.load("./files_rdf/sample.rdf");
+    size_t steps = 0;
+    while (live.isLoading())
+    {
+      tire_shell.setup(live, backup, pose, "geometric");
+      ++steps;
+    }
+    live.wait();
+    passed = passed && live.version() == 2 && snapshot == grid && live.get() != grid;
+    passed = passed && tire_shell.setup(live, backup, pose, "geometric");
+    ref_shell.setup(road, pose, "geometric");
+    real error = depthError(tire_shell, ref_shell);
+    passed = passed && error < EPSILON_ENVE;
+
+    // Loading errors do not replace the published mesh
+    bool rethrown = false;
+    ground::mesh::ptr published(live.get());
+    live.load("./files_rdf/missing.rdf");
+    try
+      {live.wait();}
+    catch (std::exception const &)
+      {rethrown = true;}
+    passed = passed && rethrown && live.version() == 2 && live.get() == published;
+
+    // Replaced snapshots are released by the container thread, never by the setup
+    std::atomic<bool> deleted(false);
+    std::thread::id   deleter;
+    bool released = false;
+    {
+      ground::container swap;
+      swap.publish(ground::mesh::ptr(new ground::mesh(triangles), [&deleted, &deleter](ground::mesh const * old) {
+        deleter = std::this_thread::get_id();
+        delete old;
+        deleted = true;
+      }));
+      tire_shell.setup(swap, backup, pose, "geometric");
+      swap.publish(grid);
+      passed = passed && !deleted;
+      tire_shell.setup(swap, backup, pose, "geometric");
+      for (size_t k = 0; k < 1000 && !deleted; ++k)
+        {std::this_thread::sleep_for(std::chrono::milliseconds(1));}
+      released = deleted && deleter != std::this_thread::get_id() && swap.released() == 1;
+      passed = passed && released;
+    }
+
+    // Output swapping data
+    std::cout
+      << "Steps during loading   = " << steps << std::endl
+      << "Max depth deviation    = " << error << std::endl
+      << "Loading error rethrown = " << (rethrown ? "yes" : "no") << std::endl
+      << "Released in background = " << (released ? "yes" : "no") << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 12: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_12.cc
+///
@@ -0,0 +1,150 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_13.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 13 - ENVE MESH INCREMENTAL UPDATE" << std::endl
+      << std::endl;
+
+    // Generate a rough road and a rutted copy of it
+    ground::generator::parameters data;
+    data.length    = 6.0;
+    data.width     = 3.0;
+    data.roughness = 'B';
+    ground::mesh road(ground::generator(data).triangles());
+    auto rut = [](point const & p) {
+      return (p.x() > 1.5 && p.x() < 4.5 && p.y() > 1.0 && p.y() < 2.0) ? -0.03 * std::sin(PI * (p.y() - 1.0)) : 0.0;
+    };
+    triangleground::vecptr rutted;
+    for (size_t i = 0; i < road.size(); ++i)
+    {
+      point vertex[3];
+      for (size_t j = 0; j < 3; ++j)
+        {vertex[j] = road[i]->vertex(j) + vec3(0.0, 0.0, rut(road[i]->vertex(j)));}
+      rutted.push_back(std::make_shared<triangleground const>(road[i]->id(), road[i]->friction(), vertex));
+    }
+    ground::mesh road_ref(rutted);
+
+    // Update the triangles that changed (with a new friction)
+    triangleground::vecidx indices;
+    std::vector<point>     vertices;
+    std::vector<real>      friction;
+    triangleground::vecptr const & triangles = road.vecptrTriangleground();
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+      if (!triangles[i]->isApprox(*rutted[i]))
+      {
+        indices.push_back(std::uint32_t(i));
+        for (size_t j = 0; j < 3; ++j)
+          {vertices.push_back(rutted[i]->vertex(j));}
+        friction.push_back(rutted[i]->friction());
+      }
+    }
+    road.update(indices, vertices, friction);
+
+    // Compare the tree queries and the shells on the updated and rebuilt meshes
+    // (both shells walk the same adjacency, so they get the same candidates order)
+    shell tire_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    shell ref_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    tire_shell.warmStart(true);
+    ref_shell.warmStart(true);
+    triangleground::vecidx local, local_ref;
+    size_t steps  = 200;
+    real   error  = 0.0, depth, depth_ref;
+    bool   passed = !indices.empty();
+    for (size_t k = 0; k < steps; ++k)
+    {
+      affine pose(translate(1.0 + 4.0 * k / steps, 1.5, 0.3));
+      tire_shell.setup(road, pose, "geometric");
+      ref_shell.setup(road_ref, pose, "geometric");
+      road.intersection(tire_shell.bbox(), local);
+      road_ref.intersection(ref_shell.bbox(), local_ref);
+      std::sort(local.begin(), local.end());
+      std::sort(local_ref.begin(), local_ref.end());
+      passed = passed && local == local_ref;
+      for (size_t i = 0; i < tire_shell.size(); ++i)
+      {
+        tire_shell.contactDepth(i, depth);
+        ref_shell.contactDepth(i, depth_ref);
+        error = std::max(error, std::abs(depth - depth_ref));
+      }
+    }
+    passed = passed && error < EPSILON_ENVE;
+
+    // Output update data
+    std::cout
+      << "Updated triangles = " << indices.size() << std::endl
+      << "Max deviation     = " << error << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 13: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_13.cc
+///
@@ -0,0 +1,155 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_14.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 14 - ENVE INSTANCED GROUND SCENE" << std::endl
+      << std::endl;
+
+    // Generate a cobblestone tile with a friction patch on its first half
+    ground::generator::parameters data;
+    data.length          = 2.0;
+    data.width           = 2.0;
+    data.roughness       = 0;
+    data.cobblestone_end = 2.0;
+    data.patches         = {{0.0, 1.0, 0.0, 2.0, 0.9}};
+    ground::mesh::ptr tile(ground::generator(data).build());
+    triangleground::vecptr const & tile_triangles = tile->vecptrTriangleground();
+    real half = 0.5 * data.length;
+
+    // Instance the tile on a row and bake the same row in a single mesh
+    size_t tiles = 20;
+    ground::scene          row;
+    triangleground::vecptr baked_triangles;
+    std::vector<affine>    poses;
+    for (size_t k = 0; k < tiles; ++k)
+    {
+      affine pose(translate(2.0 * half * k, 0.0, 0.0) * angleaxis(k % 2 ? PI : 0.0, UNITZ_VEC3) * translate(-half, -half, 0.0));
+      poses.push_back(pose);
+      row.add(tile, pose);
+      for (size_t i = 0; i < tile_triangles.size(); ++i)
+      {
+        triangleground const & tri = *tile_triangles[i];
+        baked_triangles.push_back(std::make_shared<triangleground const>(
+          baked_triangles.size(), tri.friction(), pose * tri.vertex(0), pose * tri.vertex(1), pose * tri.vertex(2)));
+      }
+    }
+    row.build();
+    ground::mesh baked(baked_triangles);
+
+    // Compare the shells on the tiles centers
+    shell scene_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    shell baked_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    real   error = 0.0, depth_scene, depth_baked;
+    point  point_scene, point_baked;
+    vec3   normal_scene, normal_baked;
+    bool   passed = true;
+    for (size_t k = 0; k < tiles; ++k)
+    {
+      affine pose(translate(2.0 * half * k + 0.1, 0.05, 0.3) * angleaxis(0.2, UNITZ_VEC3));
+      passed = scene_shell.setup(row, pose, "geometric") && passed;
+      baked_shell.setup(baked, pose, "geometric");
+      for (size_t i = 0; i < scene_shell.size(); ++i)
+      {
+        scene_shell.contactPoint(i, point_scene);
+        baked_shell.contactPoint(i, point_baked);
+        scene_shell.contactNormal(i, normal_scene);
+        baked_shell.contactNormal(i, normal_baked);
+        scene_shell.contactDepth(i, depth_scene);
+        baked_shell.contactDepth(i, depth_baked);
+        error = std::max(error, (point_scene - point_baked).norm());
+        error = std::max(error, (normal_scene - normal_baked).norm());
+        error = std::max(error, std::abs(depth_scene - depth_baked));
+      }
+    }
+    passed = passed && error < EPSILON_ENVE;
+
+    // Move the last tile away and check it follows
+    affine moved(translate(0.0, 10.0, 0.0) * poses.back());
+    row.move(tiles - 1, moved);
+    affine pose_old(translate(poses.back() * point(half, half, 0.3)));
+    affine pose_new(translate(moved * point(half, half, 0.3)));
+    bool moved_ok = !scene_shell.setup(row, pose_old, "geometric") &&
+                     scene_shell.setup(row, pose_new, "geometric");
+    passed = passed && moved_ok;
+
+    // Output scene data
+    std::cout
+      << "Instances         = " << row.size() << std::endl
+      << "Unique triangles  = " << tile->size() << std::endl
+      << "Baked triangles   = " << baked.size() << std::endl
+      << "Max deviation     = " << error << std::endl
+      << "Moved instance    = " << (moved_ok ? "ok" : "wrong") << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 14: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_14.cc
+///
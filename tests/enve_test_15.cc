@@ -0,0 +1,168 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_15.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 15 - ENVE MULTI-TILE COMPOSITE GROUND" << std::endl
+      << std::endl;
+
+    // Generate 4x2 rough road tiles as OBJ files and load them in parallel,
+    // the whole mesh is made of the same tiles
+    size_t tx = 4, ty = 2;
+    ground::generator::parameters data;
+    data.length    = 2.5;
+    data.width     = 1.5;
+    data.roughness = 'B';
+    std::vector<std::string> paths;
+    ground::composite        tiled;
+    triangleground::vecptr   triangles;
+    for (size_t b = 0; b < ty; ++b)
+    {
+      for (size_t a = 0; a < tx; ++a)
+      {
+        data.seed = std::uint32_t(b * tx + a);
+        paths.push_back("./enve_test_15_tile_" + std::to_string(b * tx + a) + ".obj");
+        ground::generator(data).write(paths.back());
+        affine pose(translate(a * data.length, b * data.width, 0.0));
+        tiled.add(paths.back(), pose);
+        ground::mesh tile(paths.back(), 1.0, pose);
+        triangles.insert(triangles.end(), tile.vecptrTriangleground().begin(), tile.vecptrTriangleground().end());
+      }
+    }
+    ground::mesh whole(triangles);
+    tiled.wait();
+    for (size_t k = 0; k < paths.size(); ++k)
+      {std::remove(paths[k].c_str());}
+    bool passed = tiled.isReady() && tiled.size() == paths.size();
+
+    // Roll the shells across the tiles seams
+    shell tiled_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    shell whole_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    size_t steps = 400;
+    real   error = 0.0, depth_tiled, depth_whole;
+    point  point_tiled, point_whole;
+    for (size_t k = 0; k < steps; ++k)
+    {
+      affine pose(translate(1.0 + 8.0 * k / steps, 1.5, 0.3) * angleaxis(0.1, UNITZ_VEC3));
+      passed = tiled_shell.setup(tiled, pose, "geometric") && passed;
+      whole_shell.setup(whole, pose, "geometric");
+      for (size_t i = 0; i < tiled_shell.size(); ++i)
+      {
+        tiled_shell.contactPoint(i, point_tiled);
+        whole_shell.contactPoint(i, point_whole);
+        tiled_shell.contactDepth(i, depth_tiled);
+        whole_shell.contactDepth(i, depth_whole);
+        error = std::max(error, (point_tiled - point_whole).norm());
+        error = std::max(error, std::abs(depth_tiled - depth_whole));
+      }
+    }
+    passed = passed && error < EPSILON_ENVE;
+
+    // Remove a tile without touching the others
+    affine pose_first(translate(1.0, 1.0, 0.3));
+    affine pose_last(translate(9.0, 2.0, 0.3));
+    ground::mesh::ptr last(tiled[paths.size() - 1]);
+    tiled.remove(0);
+    bool removed = !tiled_shell.setup(tiled, pose_first, "geometric") &&
+                    tiled_shell.setup(tiled, pose_last, "geometric") &&
+                    tiled[paths.size() - 1] == last;
+    passed = passed && removed;
+
+    // Removing a tile still loading does not wait for it
+    ground::generator::parameters large;
+    large.length = 40.0;
+    std::string large_path("./enve_test_15_large.obj");
+    ground::generator(large).write(large_path);
+    std::chrono::steady_clock::time_point tic = std::chrono::steady_clock::now();
+    ground::mesh loaded(large_path, 1.0);
+    real   time_load = lap(tic);
+    size_t i = tiled.add(large_path);
+    tiled.remove(i);
+    real   time_remove = lap(tic);
+    bool   dropped = !tiled.isLoading(i) && !tiled.isLoaded(i) && time_remove < 0.5 * time_load;
+    passed = passed && dropped;
+
+    // Let the dropped loading end before exiting
+    std::this_thread::sleep_for(std::chrono::duration<real>(2.0 * time_load));
+    std::remove(large_path.c_str());
+
+    // Output composite data
+    std::cout
+      << "Tiles         = " << tiled.size() << std::endl
+      << "Max deviation = " << error << std::endl
+      << "Removed tile  = " << (removed ? "ok" : "wrong") << std::endl
+      << "Dropped load  = " << (dropped ? "ok" : "wrong") << " (" << 1.0e3 * time_remove << " ms, load "
+      << 1.0e3 * time_load << " ms)" << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 15: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_15.cc
+///
@@ -0,0 +1,175 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_16.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 16 - ENVE PREDICTIVE TILES PREFETCHING" << std::endl
+      << std::endl;
+
+    // Generate 8 rough road tiles along x as OBJ files, register them with
+    // their bounds and build the whole mesh from the same tiles
+    size_t tx = 8;
+    ground::generator::parameters data;
+    data.length    = 2.5;
+    data.width     = 3.0;
+    data.roughness = 'B';
+    std::vector<std::string> paths;
+    std::vector<aabb>        bounds;
+    std::vector<affine>      poses;
+    triangleground::vecptr   triangles;
+    for (size_t a = 0; a < tx; ++a)
+    {
+      data.seed = std::uint32_t(a);
+      paths.push_back("./enve_test_16_tile_" + std::to_string(a) + ".obj");
+      ground::generator(data).write(paths.back());
+      poses.push_back(affine(translate(a * data.length, 0.0, 0.0)));
+      ground::mesh tile(paths.back(), 1.0, poses.back());
+      bounds.push_back(tile.bbox());
+      triangles.insert(triangles.end(), tile.vecptrTriangleground().begin(), tile.vecptrTriangleground().end());
+    }
+    ground::mesh whole(triangles);
+
+    // Drive the shell along the tiles with and without prediction
+    shell tiled_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    shell whole_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    size_t steps = 200;
+    real   speed = 20.0, dt = 17.0 / speed / steps;
+    real   error = 0.0, depth_tiled, depth_whole;
+    point  point_tiled, point_whole;
+    bool   passed = true;
+    ground::prefetcher::metrics stats[3];
+    real   horizon[3]  = {0.0, 0.5, 0.1};
+    size_t resident[3] = {tx, tx, 4};
+    size_t loaded      = 0;
+    for (size_t h = 0; h < 3; ++h)
+    {
+      ground::composite tiled;
+      for (size_t a = 0; a < tx; ++a)
+        {tiled.add(paths[a], bounds[a], poses[a]);}
+      ground::prefetcher service(tiled, horizon[h], 0.1, resident[h]);
+      for (size_t k = 0; k < steps; ++k)
+      {
+        affine pose(translate(1.0 + speed * dt * k, 1.5, 0.3) * angleaxis(0.1, UNITZ_VEC3));
+        whole_shell.setup(whole, pose, "geometric");
+        service.update(*whole_shell.bbox(), vec3(speed, 0.0, 0.0));
+        passed = tiled_shell.setup(tiled, pose, "geometric") && passed;
+        for (size_t i = 0; i < tiled_shell.size(); ++i)
+        {
+          tiled_shell.contactPoint(i, point_tiled);
+          whole_shell.contactPoint(i, point_whole);
+          tiled_shell.contactDepth(i, depth_tiled);
+          whole_shell.contactDepth(i, depth_whole);
+          error = std::max(error, (point_tiled - point_whole).norm());
+          error = std::max(error, std::abs(depth_tiled - depth_whole));
+        }
+        std::this_thread::sleep_for(std::chrono::duration<real>(dt));
+      }
+      stats[h] = service.stats();
+      loaded   = 0;
+      for (size_t a = 0; a < tx; ++a)
+        {loaded += tiled.isLoaded(a);}
+    }
+    passed = passed && error < EPSILON_ENVE && stats[1].stalls < stats[0].stalls &&
+             stats[1].evictions == 0 && stats[2].evictions > 0 && loaded <= resident[2];
+
+    // Stopping the prefetcher fails the queued tiles instead of loading them
+    bool stopped = true;
+    {
+      ground::composite tiled;
+      for (size_t a = 0; a < tx; ++a)
+        {tiled.add(paths[a], bounds[a], poses[a]);}
+      {
+        ground::prefetcher service(tiled, 1.0, 0.1);
+        service.update(aabb(0.1, 0.1, -0.1, 0.5, 0.5, 0.1), vec3(20.0, 0.0, 0.0));
+      }
+      tiled.update();
+      for (size_t a = 0; a < tx; ++a)
+        {stopped = stopped && !tiled.isLoading(a);}
+      stopped = stopped && tiled.isLoaded(0);
+    }
+    for (size_t a = 0; a < tx; ++a)
+      {std::remove(paths[a].c_str());}
+    passed = passed && stopped;
+
+    // Output prefetching data
+    std::cout
+      << "Max deviation     = " << error << std::endl
+      << "Stalls (reactive) = " << stats[0].stalls << " (" << stats[0].stall_time << " s)" << std::endl
+      << "Stalls (horizon)  = " << stats[1].stalls << " (" << stats[1].stall_time << " s)" << std::endl
+      << "Hits   (horizon)  = " << stats[1].hits << std::endl
+      << "Requests          = " << stats[1].requests << std::endl
+      << "Evictions         = " << stats[2].evictions << " (" << loaded << " tiles resident)" << std::endl
+      << "Stopped queue     = " << (stopped ? "ok" : "wrong") << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 16: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_16.cc
+///
@@ -0,0 +1,157 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_17.cc
+///
+
+#include "enve.hh"
+
+#include <random>
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 17 - ENVE MORTON TRIANGLES REORDERING" << std::endl
+      << std::endl;
+
+    // Generate a rough road mesh with the triangles in random order
+    ground::generator::parameters data;
+    data.length    = 5.0;
+    data.width     = 2.0;
+    data.roughness = 'B';
+    size_t nx = 100, ny = 40;
+    triangleground::vecptr triangles(ground::generator(data).triangles());
+    std::mt19937 generator(17);
+    std::shuffle(triangles.begin(), triangles.end(), generator);
+    ground::mesh shuffled(triangles);
+    ground::mesh sorted(triangles);
+    sorted.reorder();
+
+    // Check the IDs preservation, the triangles contiguity in the Morton order
+    // and the edge-neighbours consistency
+    triangleground::vecptr original(triangles.size());
+    for (size_t i = 0; i < triangles.size(); ++i)
+      {original[triangles[i]->id()] = triangles[i];}
+    bool remapped = sorted.size() == shuffled.size() &&
+                    sorted.bbox().isApprox(shuffled.bbox(), EPSILON_ENVE);
+    size_t boundary[2] = {0, 0};
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+      remapped = remapped && sorted[i] != original[sorted[i]->id()] &&
+                 sorted[i]->isApprox(*original[sorted[i]->id()], EPSILON_ENVE) &&
+                 (i == 0 || sorted[i].get() == sorted[i-1].get() + 1);
+      for (size_t j = 0; j < 3; ++j)
+      {
+        std::uint32_t n = sorted.neighbour(i, j);
+        boundary[0] += shuffled.neighbour(i, j) == NONE_INDEX;
+        boundary[1] += n == NONE_INDEX;
+        remapped = remapped && (n == NONE_INDEX ||
+          sorted.neighbour(n, 0) == i || sorted.neighbour(n, 1) == i || sorted.neighbour(n, 2) == i);
+      }
+    }
+    remapped = remapped && boundary[0] == boundary[1] && boundary[0] == 2 * (nx + ny);
+
+    // Check that spatially close triangles are close in memory
+    triangleground::vecidx indices;
+    real span[2] = {0.0, 0.0};
+    aabb box(2.0, 0.8, -1.0, 2.4, 1.2, 1.0);
+    shuffled.intersection(box, indices);
+    span[0] = *std::max_element(indices.begin(), indices.end()) - *std::min_element(indices.begin(), indices.end());
+    sorted.intersection(box, indices);
+    span[1] = *std::max_element(indices.begin(), indices.end()) - *std::min_element(indices.begin(), indices.end());
+
+    // Compare the contact outputs of the sampling method (order independent)
+    shell shell_shuffled(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    shell shell_sorted(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    real  error = 0.0, depth_shuffled, depth_sorted;
+    point point_shuffled, point_sorted;
+    for (size_t k = 0; k < 100; ++k)
+    {
+      affine pose(translate(0.5 + 0.04 * k, 1.0, 0.3) * angleaxis(0.1, UNITZ_VEC3));
+      shell_shuffled.setup(shuffled, pose, "sampling");
+      shell_sorted.setup(sorted, pose, "sampling");
+      for (size_t i = 0; i < shell_sorted.size(); ++i)
+      {
+        shell_shuffled.contactPoint(i, point_shuffled);
+        shell_sorted.contactPoint(i, point_sorted);
+        shell_shuffled.contactDepth(i, depth_shuffled);
+        shell_sorted.contactDepth(i, depth_sorted);
+        error = std::max(error, (point_shuffled - point_sorted).norm());
+        error = std::max(error, std::abs(depth_shuffled - depth_sorted));
+      }
+    }
+    bool passed = remapped && span[1] < span[0] && error < EPSILON_ENVE;
+
+    // Output reordering data
+    std::cout
+      << "Remapping       = " << (remapped ? "ok" : "wrong") << std::endl
+      << "Span (shuffled) = " << span[0] << std::endl
+      << "Span (Morton)   = " << span[1] << std::endl
+      << "Max deviation   = " << error << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 17: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_17.cc
+///
@@ -0,0 +1,136 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_18.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 18 - ENVE COMPRESSED MESH" << std::endl
+      << std::endl;
+
+    // Generate a rough road and load it far from the origin (millimetre resolution)
+    real x0 = 1500.0, y0 = -800.0;
+    ground::generator::parameters data;
+    data.length    = 10.0;
+    data.width     = 3.0;
+    data.roughness = 'B';
+    std::string path("./enve_test_18_road.obj");
+    ground::generator(data).write(path);
+    ground::mesh road(path, 0.9, affine(translate(x0, y0, 0.0)));
+    std::remove(path.c_str());
+    ground::compressed packed(road, 1.0e-3);
+
+    // Check the decoding error
+    real error_vertex = 0.0;
+    for (size_t i = 0; i < packed.size(); ++i)
+    {
+      for (size_t j = 0; j < 3; ++j)
+        {error_vertex = std::max(error_vertex, (packed.vertex(i, j) - road[i]->vertex(j)).cwiseAbs().maxCoeff());}
+    }
+    bool passed = packed.size() == road.size() &&
+                  error_vertex <= 0.5 * packed.resolution() + EPSILON_ENVE &&
+                  packed.decode(7)->id() == integer(7) &&
+                  std::abs(packed.decode(7)->friction() - road[7]->friction()) < 1.0e-6;
+
+    // Roll the shells on both meshes
+    shell road_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    shell packed_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    std::string methods[2] = {"sampling", "geometric"};
+    real  error_contact = 0.0, depth_road, depth_packed;
+    point point_road, point_packed;
+    for (size_t m = 0; m < 2; ++m)
+    {
+      for (size_t k = 0; k < 200; ++k)
+      {
+        affine pose(translate(x0 + 1.0 + 0.04 * k, y0 + 1.5, 0.3) * angleaxis(0.1, UNITZ_VEC3));
+        passed = road_shell.setup(road, pose, methods[m]) == packed_shell.setup(packed, pose, methods[m]) && passed;
+        for (size_t i = 0; i < road_shell.size(); ++i)
+        {
+          road_shell.contactPoint(i, point_road);
+          packed_shell.contactPoint(i, point_packed);
+          road_shell.contactDepth(i, depth_road);
+          packed_shell.contactDepth(i, depth_packed);
+          error_contact = std::max(error_contact, (point_road - point_packed).norm());
+          error_contact = std::max(error_contact, std::abs(depth_road - depth_packed));
+        }
+      }
+    }
+    // The geometric contact point is a volume-weighted mean, sensitive to the decoding error
+    passed = passed && error_contact < 5.0 * packed.resolution();
+
+    // Output compressed mesh data
+    std::cout
+      << "Triangles       = " << packed.size() << std::endl
+      << "Vertex error    = " << error_vertex << std::endl
+      << "Contact error   = " << error_contact << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 18: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_18.cc
+///
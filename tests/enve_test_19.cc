@@ -0,0 +1,178 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_19.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Vertical deviation of a point from a mesh (NaN if not covered)
+real
+deviation(
+  ground::mesh const & road,
+  point        const & p
+)
+{
+  triangleground::vecidx indices;
+  vec3 eps(1.0e-9, 1.0e-9, 1.0);
+  road.intersection(aabb(p - eps, p + eps), indices);
+  real result = QUIET_NAN;
+  for (size_t k = 0; k < indices.size(); ++k)
+  {
+    triangleground const & t = *road[indices[k]];
+    point const & p0 = t.vertex(0), & p1 = t.vertex(1), & p2 = t.vertex(2);
+    real a  = (p1.x() - p0.x()) * (p2.y() - p0.y()) - (p2.x() - p0.x()) * (p1.y() - p0.y());
+    real w0 = ((p1.x() - p.x()) * (p2.y() - p.y()) - (p2.x() - p.x()) * (p1.y() - p.y())) / a;
+    real w1 = ((p.x() - p0.x()) * (p2.y() - p0.y()) - (p2.x() - p0.x()) * (p.y() - p0.y())) / a;
+    real w2 = 1.0 - w0 - w1;
+    if (w0 >= -1.0e-9 && w1 >= -1.0e-9 && w2 >= -1.0e-9)
+    {
+      real d = std::abs(w0 * p0.z() + w1 * p1.z() + w2 * p2.z() - p.z());
+      result = std::isnan(result) ? d : std::min(result, d);
+    }
+  }
+  return result;
+}
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 19 - ENVE MESH DECIMATION AND LEVELS OF DETAIL" << std::endl
+      << std::endl;
+
+    // Generate a smooth road with a pothole, kerbs and a friction patch
+    ground::generator::parameters data;
+    data.length      = 10.0;
+    data.width       = 4.0;
+    data.spacing     = 0.1;
+    data.roughness   = 0;
+    data.potholes    = 1;
+    data.kerb_height = 0.02;
+    data.patches     = {{0.0, 3.0, 0.0, 4.0, 0.8}};
+    data.seed        = 19;
+    ground::generator generated(data);
+    ground::mesh::ptr road(generated.build());
+    std::vector<point> vertices;
+    size_t nx = 100, ny = 40;
+    real   d  = data.spacing;
+    for (size_t j = 0; j <= ny; ++j)
+    {
+      for (size_t i = 0; i <= nx; ++i)
+        {vertices.push_back(point(i * d, j * d, generated.height(i * d, j * d)));}
+    }
+
+    // Build the levels of detail
+    std::vector<real> tolerances = {1.0e-4, 1.0e-3};
+    ground::lod levels(road, tolerances);
+    bool passed = levels.size() == 3 &&
+                  levels[1]->size() < road->size() / 4 &&
+                  levels[2]->size() < levels[1]->size() &&
+                  levels.level(5.0e-4) == levels[1] &&
+                  levels.level(0.0) == road;
+
+    // Check the vertical deviation at the original vertices
+    real error[2] = {0.0, 0.0};
+    for (size_t l = 0; l < 2; ++l)
+    {
+      for (size_t k = 0; k < vertices.size(); ++k)
+      {
+        real dev = deviation(*levels[l + 1], vertices[k]);
+        error[l] = std::isnan(dev) ? real(1.0) : std::max(error[l], dev);
+      }
+      passed = passed && error[l] <= tolerances[l] + EPSILON_ENVE;
+    }
+
+    // Check the friction boundaries preservation
+    bool preserved = true;
+    for (size_t l = 1; l < levels.size(); ++l)
+    {
+      for (size_t i = 0; i < levels[l]->size(); ++i)
+      {
+        triangleground const & t = *(*levels[l])[i];
+        point centroid((t.vertex(0) + t.vertex(1) + t.vertex(2)) / 3.0);
+        preserved = preserved && t.friction() == generated.friction(centroid.x(), centroid.y());
+      }
+    }
+    passed = passed && preserved;
+
+    // Write and reload a single level
+    ground::decimator simplified(*road);
+    simplified.simplify(1.0e-3);
+    simplified.write("./enve_test_19.rdf");
+    ground::mesh reloaded("./enve_test_19.rdf");
+    std::remove("./enve_test_19.rdf");
+    passed = passed && reloaded.size() == simplified.size() && simplified.size() < levels[1]->size();
+
+    // Output decimation data
+    std::cout
+      << "Triangles (level 0) = " << levels[0]->size() << std::endl
+      << "Triangles (level 1) = " << levels[1]->size() << " (max deviation " << error[0] << " m)" << std::endl
+      << "Triangles (level 2) = " << levels[2]->size() << " (max deviation " << error[1] << " m)" << std::endl
+      << "Friction boundaries = " << (preserved ? "ok" : "wrong") << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 19: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_19.cc
+///
@@ -0,0 +1,183 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_20.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Root mean square height of a road along the right track
+real
+rms(
+  ground::generator const & road
+)
+{
+  real sum = 0.0;
+  size_t n = 2000;
+  for (size_t i = 0; i < n; ++i)
+    {sum += std::pow(road.height(road.data().length * i / n, 0.0), 2);}
+  return std::sqrt(sum / n);
+}
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 20 - ENVE PROCEDURAL ROAD GENERATOR" << std::endl
+      << std::endl;
+
+    // Road with every feature enabled
+    ground::generator::parameters data;
+    data.length             = 20.0;
+    data.width              = 3.0;
+    data.spacing            = 0.1;
+    data.roughness          = 'C';
+    data.kerb_height        = 0.1;
+    data.potholes           = 4;
+    data.cobblestone_start  = 12.0;
+    data.cobblestone_end    = 16.0;
+    data.banking            = 0.02;
+    data.friction           = 0.9;
+    data.seed               = 42;
+    data.patches.push_back({5.0, 8.0, 0.0, 1.5, 0.4});
+
+    // Same seed gives the same road, a different seed gives another road
+    ground::generator road(data), same(data);
+    data.seed = 43;
+    ground::generator other(data);
+    bool deterministic = true, different = false;
+    for (size_t i = 0; i < 200; ++i)
+    {
+      real x = 0.1 * i, y = 0.015 * i;
+      deterministic = deterministic && road.height(x, y) == same.height(x, y);
+      different     = different || road.height(x, y) != other.height(x, y);
+    }
+    bool passed = deterministic && different && road.size() == 2 * 200 * 30;
+
+    // Roughness grows with the ISO 8608 class
+    ground::generator::parameters smooth;
+    smooth.spacing = 0.1;
+    real rms_class[3];
+    char classes[3] = {'A', 'C', 'E'};
+    for (size_t k = 0; k < 3; ++k)
+    {
+      smooth.roughness = classes[k];
+      rms_class[k] = rms(ground::generator(smooth));
+    }
+    passed = passed && rms_class[0] < rms_class[1] && rms_class[1] < rms_class[2];
+
+    // Friction patches, kerbs, banking and potholes
+    ground::generator::parameters flat;
+    flat.length      = 10.0;
+    flat.roughness   = 0;
+    flat.kerb_height = 0.1;
+    flat.banking     = 0.05;
+    flat.potholes    = 1;
+    flat.patches.push_back({2.0, 3.0, 1.0, 2.0, 0.5});
+    ground::generator features(flat);
+    ground::generator::pothole const & hole = features.potholes()[0];
+    flat.potholes = 0;
+    ground::generator intact(flat);
+    real slope = (features.height(1.0, 2.5) - features.height(1.0, 1.5)) / 1.0;
+    passed = passed &&
+             features.friction(2.5, 1.5) == 0.5 && features.friction(3.5, 1.5) == 1.0 &&
+             std::abs(slope - std::tan(flat.banking)) < 1.0e-9 &&
+             std::abs(features.height(0.5, 0.1) - features.height(0.5, 0.5) - 0.1 + 0.4 * std::tan(flat.banking)) < 1.0e-9 &&
+             std::abs(intact.height(hole.x, hole.y) - features.height(hole.x, hole.y) - hole.depth) < 1.0e-9;
+
+    // Streamed file and in memory mesh agree
+    road.write("./enve_test_20.rdf");
+    ground::mesh reloaded("./enve_test_20.rdf");
+    std::remove("./enve_test_20.rdf");
+    ground::mesh::ptr built(road.build());
+    passed = passed && reloaded.size() == road.size() && built->size() == road.size();
+    shell shell_built(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    shell shell_reloaded(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    real error = 0.0;
+    point point_built, point_reloaded;
+    for (size_t k = 0; k < 20; ++k)
+    {
+      affine pose(translate(4.0 + 0.5 * k, 1.2, 0.3));
+      passed = shell_built.setup(*built, pose, "sampling") == shell_reloaded.setup(reloaded, pose, "sampling") && passed;
+      for (size_t i = 0; i < shell_built.size(); ++i)
+      {
+        shell_built.contactPoint(i, point_built);
+        shell_reloaded.contactPoint(i, point_reloaded);
+        error = std::max(error, (point_built - point_reloaded).norm());
+      }
+    }
+    passed = passed && error < 1.0e-6;
+
+    // Output generator data
+    std::cout
+      << "Triangles           = " << road.size() << std::endl
+      << "Deterministic       = " << (deterministic ? "yes" : "no") << std::endl
+      << "RMS (class A, C, E) = " << rms_class[0] << ", " << rms_class[1] << ", " << rms_class[2] << " m" << std::endl
+      << "Banking slope       = " << slope << std::endl
+      << "Reload deviation    = " << error << " m" << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 20: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_20.cc
+///
@@ -0,0 +1,146 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_21.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 21 - ENVE SHELL SETUP STATISTICS" << std::endl
+      << std::endl;
+
+    // Generate a rough road
+    ground::generator::parameters data;
+    data.length    = 10.0;
+    data.width     = 3.0;
+    data.spacing   = 0.1;
+    data.roughness = 'C';
+    ground::mesh::ptr road(ground::generator(data).build());
+
+    // Roll the shell on the road and lift it off at the end
+    shell tire_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    size_t steps = 40, contacts = 0;
+    std::string methods[2] = {"geometric", "sampling"};
+    for (size_t m = 0; m < 2; ++m)
+    {
+      for (size_t k = 0; k < steps; ++k)
+      {
+        real z = k + 1 < steps ? 0.3 : 1.0;
+        affine pose(translate(1.0 + 0.2 * k, 1.5, z));
+        tire_shell.setup(*road, pose, methods[m]);
+        for (size_t i = 0; i < tire_shell.size(); ++i)
+        {
+          real depth;
+          tire_shell.contactDepth(i, depth);
+          contacts += depth > 0.0;
+        }
+      }
+    }
+    statistics stats(tire_shell.stats());
+    size_t ribs = 2 * steps * tire_shell.size();
+
+    // Check the counters consistency
+    bool passed;
+    if (shell::hasStats())
+    {
+      passed = stats.setups == 2 * steps &&
+               stats.queried > size_t(0) &&
+               stats.candidates > size_t(0) &&
+               stats.candidates <= tire_shell.size() * stats.queried &&
+               stats.tests >= stats.hits && stats.hits > size_t(0) &&
+               stats.fallbacks + contacts == ribs &&
+               stats.time_query > 0.0 && stats.time_refine > 0.0 && stats.time_envelop > 0.0;
+    }
+    else
+    {
+      passed = stats.setups == 0 && stats.tests == 0 && stats.time_envelop == 0.0;
+    }
+
+    // Reset the counters (kept across a ribs resize)
+    tire_shell.resetStats();
+    tire_shell.setup(*road, affine(translate(2.0, 1.5, 0.3)), "sampling");
+    size_t tests = tire_shell.stats().tests;
+    tire_shell.resize(20);
+    passed = passed && tire_shell.stats().tests == tests && tire_shell.stats().setups == size_t(shell::hasStats());
+
+    // Output statistics data
+    std::cout
+      << "Statistics compiled = " << (shell::hasStats() ? "yes" : "no") << std::endl
+      << "Setups              = " << stats.setups << std::endl
+      << "Queried triangles   = " << stats.queried << std::endl
+      << "Rib candidates      = " << stats.candidates << std::endl
+      << "Tests (hits)        = " << stats.tests << " (" << stats.hits << ")" << std::endl
+      << "Fallbacks           = " << stats.fallbacks << std::endl
+      << "Query time          = " << stats.time_query << " s" << std::endl
+      << "Refine time         = " << stats.time_refine << " s" << std::endl
+      << "Envelop time        = " << stats.time_envelop << " s" << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 21: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_21.cc
+///
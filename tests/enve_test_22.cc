@@ -0,0 +1,143 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_22.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 22 - ENVE TIMELINE TRACING" << std::endl
+      << std::endl;
+
+    // Record on two threads with small ring buffers
+    tracer::start(10);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < 2; ++t)
+    {
+      workers.emplace_back([]() {
+        for (size_t k = 0; k < 100; ++k)
+          {tracer::span work("test::work");}
+      });
+    }
+    for (size_t t = 0; t < workers.size(); ++t)
+      {workers[t].join();}
+    bool passed = tracer::size() == 2 * 16 && tracer::threads() == 2;
+
+    // Trace a loaded road with the shell rolling on it
+    tracer::clear();
+    tracer::start();
+    ground::generator::parameters data;
+    data.length    = 10.0;
+    data.width     = 3.0;
+    data.spacing   = 0.1;
+    data.roughness = 'B';
+    ground::generator(data).write("./enve_test_22.rdf");
+    ground::mesh road("./enve_test_22.rdf");
+    std::remove("./enve_test_22.rdf");
+    shell tire_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    point contact;
+    for (size_t k = 0; k < 20; ++k)
+    {
+      tire_shell.setup(road, affine(translate(1.0 + 0.4 * k, 1.5, 0.3)), "geometric");
+      tire_shell.contactPoint(contact);
+    }
+    {
+      tracer::span step("test::step");
+    }
+    tracer::stop();
+    size_t recorded = tracer::size();
+    {
+      tracer::span ignored("test::ignored");
+    }
+    passed = passed && tracer::size() == recorded && !tracer::isEnabled();
+
+    // Export and check the trace content
+    passed = passed && tracer::write("./enve_test_22.json");
+    std::ifstream file("./enve_test_22.json");
+    std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove("./enve_test_22.json");
+    passed = passed &&
+             json.find("\"traceEvents\"") != std::string::npos &&
+             json.find("\"test::step\"") != std::string::npos &&
+             json.find("\"test::ignored\"") == std::string::npos &&
+             json.find("\"test::work\"") == std::string::npos;
+    char const * names[5] = {"mesh::load", "mesh::buildAABBtree", "shell::setup", "shell::query", "rib::envelop"};
+    for (size_t i = 0; i < 5; ++i)
+      {passed = passed && (json.find(names[i]) != std::string::npos) == tracer::hasTrace();}
+
+    // Output tracing data
+    std::cout
+      << "Library spans compiled = " << (tracer::hasTrace() ? "yes" : "no") << std::endl
+      << "Recorded events        = " << recorded << std::endl
+      << "Trace size             = " << json.size() << " bytes" << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 22: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_22.cc
+///
@@ -0,0 +1,126 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_23.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 23 - ENVE MEMORY FOOTPRINT ACCOUNTING" << std::endl
+      << std::endl;
+
+    // Generated road and its layouts
+    ground::generator::parameters data;
+    data.length  = 20.0;
+    data.width   = 3.0;
+    data.spacing = 0.05;
+    ground::mesh::ptr road(ground::generator(data).build());
+    ground::compressed packed(*road);
+    footprint mesh_usage(road->memoryUsage()), packed_usage(packed.memoryUsage());
+    size_t n = road->size();
+
+    // Per-triangle data of the mesh layout (the packed vertices are a single
+    // precision copy only)
+    bool packed_vertices = sizeof(real_storage) < sizeof(real);
+    bool passed =
+      mesh_usage.triangles == n * (sizeof(triangleground) - sizeof(aabb)) &&
+      mesh_usage.control   == n * CONTROL_BLOCK_BYTES &&
+      mesh_usage.pointers  >= n * sizeof(triangleground::ptr) &&
+      (packed_vertices ? mesh_usage.vertices >= 9 * n * sizeof(real_storage) : mesh_usage.vertices == 0) &&
+      mesh_usage.adjacency >= 3 * n * sizeof(std::uint32_t) &&
+      mesh_usage.boxes     >= n * sizeof(aabb) &&
+      mesh_usage.nodes > 0 && mesh_usage.indices >= n * sizeof(std::uint32_t) &&
+      mesh_usage.candidates == 0;
+
+    // The quantized layout is smaller and has no triangle objects
+    passed = passed &&
+             packed_usage.triangles == 0 && packed_usage.control == 0 &&
+             packed_usage.total() < mesh_usage.total() / 4;
+
+    // Totals add up
+    footprint sum(mesh_usage);
+    sum += packed_usage;
+    passed = passed && sum.total() == mesh_usage.total() + packed_usage.total();
+
+    // Shell candidates buffers grow with the setup
+    shell tire_shell(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    footprint before(tire_shell.memoryUsage());
+    tire_shell.setup(*road, affine(translate(5.0, 1.5, 0.3)), "sampling");
+    footprint after(tire_shell.memoryUsage());
+    passed = passed && after.candidates > before.candidates && before.other > 0;
+
+    // Output footprint data
+    std::cout
+      << "Mesh bytes per triangle       = " << real(mesh_usage.total()) / n << std::endl
+      << "Compressed bytes per triangle = " << real(packed_usage.total()) / n << std::endl
+      << "Shell bytes (before, after)   = " << before.total() << ", " << after.total() << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 23: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_23.cc
+///
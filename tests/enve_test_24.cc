@@ -0,0 +1,139 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_test_24.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TEST 24 - ENVE MESH LOAD REPORT" << std::endl
+      << std::endl;
+
+    // Collect the reports through the sink
+    std::mutex mutex;
+    std::vector<loadreport> reports;
+    ground::mesh::setSink([&mutex, &reports](loadreport const & report) {
+      std::lock_guard<std::mutex> lock(mutex);
+      reports.push_back(report);
+    });
+
+    // RDF file load
+    std::string path("./files_rdf/sample.rdf");
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    size_t file_bytes = size_t(file.tellg());
+    ground::mesh road(path);
+    loadreport const & rdf = road.loadReport();
+    bool passed =
+      reports.size() == 1 && reports[0].path == path && rdf.format == "rdf" &&
+      rdf.nodes == 8 && rdf.elements == road.size() &&
+      rdf.bytes >= file_bytes && rdf.bytes <= file_bytes + 1 && rdf.lines > rdf.nodes + rdf.elements &&
+      rdf.time_read + rdf.time_tokenize + rdf.time_convert + rdf.time_construct <= rdf.time_parse + 1.0e-9 &&
+      rdf.time_boxes >= 0.0 && rdf.time_adjacency >= 0.0 && rdf.time_tree >= 0.0 &&
+      rdf.time_parse + rdf.time_boxes + rdf.time_adjacency + rdf.time_tree <= rdf.time_total &&
+      rdf.mesh_memory == road.memoryUsage().total();
+#if defined(__unix__) || defined(__APPLE__)
+    passed = passed && rdf.peak_memory > 0;
+#endif
+    rdf.print(std::cout);
+
+    // OBJ file load with Morton reordering
+    ground::mesh road_obj("./files_obj/sample.obj", 1.0, IDENTITY_AFFINE, true);
+    loadreport const & obj = road_obj.loadReport();
+    passed = passed &&
+      reports.size() == 2 && obj.format == "obj" && obj.elements == road_obj.size() &&
+      obj.nodes > 0 && obj.time_reorder >= 0.0 && obj.time_reorder <= obj.time_total;
+
+    // Background loads report from their own thread
+    ground::mesh::future road_async = ground::mesh::loadAsync(path);
+    passed = passed && road_async.get()->loadReport().elements == rdf.elements && reports.size() == 3;
+
+    // Meshes built from triangles report the tree build only
+    ground::generator::parameters data;
+    data.length  = 5.0;
+    data.width   = 2.0;
+    data.spacing = 0.1;
+    ground::mesh::ptr generated(ground::generator(data).build());
+    loadreport const & built = generated->loadReport();
+    passed = passed && reports.size() == 3 && built.path.empty() && built.bytes == 0 && built.time_tree > 0.0;
+
+    // Clearing the mesh resets the report, an empty sink disables the reports
+    // and the loads (in background too) print nothing
+    road.clear();
+    ground::mesh::setSink(ground::mesh::sink());
+    std::ostringstream quiet;
+    std::streambuf * console = std::cout.rdbuf(quiet.rdbuf());
+    ground::mesh road_quiet(path);
+    ground::mesh::ptr road_quiet_async(ground::mesh::loadAsync(path).get());
+    std::cout.rdbuf(console);
+    passed = passed && road.loadReport().elements == 0 && reports.size() == 3 && quiet.str().empty() &&
+             road_quiet.loadReport().elements == reports[0].elements && road_quiet_async->size() == road_quiet.size();
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TEST 24: " << (passed ? "Completed" : "Failed") << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return passed ? 0 : 1;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_test_24.cc
+///
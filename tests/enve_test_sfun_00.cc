@@ -62,8 +62,22 @@ main(void)
     EnveRealPar FlatHeightPar   = 0.0; // Flat ground surface height (m)
     EnveRealPar FlatFrictionPar = 1.0; // Flat ground surface friction scaling coefficient (-)
 
-    // S-function entry point for initialization
+    // S-function entry point for initialization (two blocks sharing the same ground)
+    void *work1[1] = {nullptr};
+    void *work2[1] = {nullptr};
     enve_sfun_init(
+       work1,           // Block instance work pointer
+       &SizePar,        // Ribs number (-)
+       &Rx,             // Shell radius on x-axis (m)
+       &Mx,             // Shell curve degree for x-axis (-)
+       &Ry,             // Shell radius on y-axis (m)
+       &My,             // Shell curve degree for y-axis (-)
+       &Ly,             // Surface half width on y-axis (m)
+       &FlatHeightPar,  // Flat ground surface height (m)
+       &FlatFrictionPar // Flat ground surface friction scaling coefficient (-)
+    );
+    enve_sfun_init(
+       work2,           // Block instance work pointer
        &SizePar,        // Ribs number (-)
        &Rx,             // Shell radius on x-axis (m)
        &Mx,             // Shell curve degree for x-axis (-)
@@ -113,24 +127,38 @@ main(void)
     std::cout << "\b\b ]" << std::endl;
 
     // Output bus containing the contact data
-    EnveOutputBus output1, output2;
+    EnveOutputBus output1, output2, output3;
 
     EnveRealPar flat_enable = 0; // method 0: ENVE use geometric enveloping, 1: ENVE use sampling enveloping
     EnveRealPar method      = 0; // flat_enable 0: ENVE use ground::mesh (RDF), 1: ENVE use ground::flat
 
     // S-function entry point for step update
     enve_sfun_out(
+      work1,       // Block instance work pointer
       &input1,     // Input bus containing the shell hub affine transformation matrix
       &output1,    // Output bus containing the contact data
       &method,     // method 0: ENVE use geometric enveloping, 1: ENVE use sampling enveloping
       &flat_enable // flat_enable 0: ENVE use ground::mesh, 1: ENVE use ground::flat
     );
     enve_sfun_out(
+      work1,       // Block instance work pointer
       &input2,     // Input bus containing the shell hub affine transformation matrix
       &output2,    // Output bus containing the contact data
       &method,     // method 0: ENVE use geometric enveloping, 1: ENVE use sampling enveloping
       &flat_enable // flat_enable 0: ENVE use ground::mesh, 1: ENVE use ground::flat
     );
+    enve_sfun_out(
+      work2,       // Block instance work pointer
+      &input2,     // Input bus containing the shell hub affine transformation matrix
+      &output3,    // Output bus containing the contact data
+      &method,     // method 0: ENVE use geometric enveloping, 1: ENVE use sampling enveloping
+      &flat_enable // flat_enable 0: ENVE use ground::mesh, 1: ENVE use ground::flat
+    );
+
+    // Check that the two blocks give the same results
+    bool passed = output3.InMesh == output2.InMesh;
+    for (integer i = 0; i < 16; ++i)
+      {passed = passed && output3.ShellAffine[i] == output2.ShellAffine[i];}
 
     // Output performance data
     std::cout
@@ -161,14 +189,19 @@ main(void)
       << pose3
       << pose4 << std::endl;
 
+    // S-function entry point for deletion of allocated memory
+    enve_sfun_end(work1);
+    enve_sfun_end(work2);
+    passed = passed && work1[0] == nullptr && work2[0] == nullptr;
+
     // End of test
     std::cout
       << std::endl
-      << "TEST SFUN 00: Completed" << std::endl
+      << "TEST SFUN 00: " << (passed ? "Completed" : "Failed") << std::endl
       << "---------------------------" << std::endl;
 
     // Exit the program
-    return 0;
+    return passed ? 0 : 1;
   }
 
   // Exception catch block
@@ -185,6 +218,7 @@ main(void)
       << "Aborted test: unknown error" << std::endl
       << "---------------------------" << std::endl;
   }
+  return 1;
 }
 
 ///
@@ -0,0 +1,142 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_timing_02.cc
+///
+
+#include "enve.hh"
+#include "TicToc.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TIMING 02 - ENVE MESH REFIT VS REBUILD" << std::endl
+      << std::endl;
+
+    // Instantiate a TicToc object
+    TicToc tictoc;
+
+    // Generate a large smooth road (nx by ny grid cells)
+    size_t nx = 500, ny = 500;
+    ground::generator::parameters data;
+    data.length    = nx * data.spacing;
+    data.width     = ny * data.spacing;
+    data.roughness = 0;
+    ground::mesh road(ground::generator(data).triangles());
+
+    // Deform a patch of the grid per step (soft soil rutting)
+    size_t patch = 40, steps = 50;
+    real   time_refit = 0.0, time_rebuild = 0.0;
+    triangleground::vecidx indices;
+    std::vector<point>     vertices;
+    std::vector<real>      friction;
+    for (size_t k = 0; k < steps; ++k)
+    {
+      indices.clear();
+      vertices.clear();
+      friction.clear();
+      size_t i0 = (k * 7) % (nx - patch), j0 = (k * 3) % (ny - patch);
+      for (size_t j = j0; j < j0 + patch; ++j)
+      {
+        for (size_t i = i0; i < i0 + patch; ++i)
+        {
+          for (size_t t = 0; t < 2; ++t)
+          {
+            std::uint32_t index = std::uint32_t(2 * (i * ny + j) + t);
+            triangleground const & tri = *road[index];
+            indices.push_back(index);
+            for (size_t v = 0; v < 3; ++v)
+              {vertices.push_back(tri.vertex(v) - vec3(0.0, 0.0, 0.001));}
+            friction.push_back(0.9 * tri.friction());
+          }
+        }
+      }
+
+      // Refit only the affected nodes
+      tictoc.tic();
+      road.update(indices, vertices, friction);
+      tictoc.toc();
+      time_refit += tictoc.elapsed_ms();
+
+      // Full rebuild of the same mesh
+      tictoc.tic();
+      road.buildAABBtree();
+      tictoc.toc();
+      time_rebuild += tictoc.elapsed_ms();
+    }
+
+    // Output performance data
+    std::cout
+      << "ENVE PERFORMANCE REPORT" << std::endl
+      << "Triangles          = " << road.size() << std::endl
+      << "Updated per step   = " << indices.size() << std::endl
+      << "Avg. refit time    = " << time_refit / steps << " ms" << std::endl
+      << "Avg. rebuild time  = " << time_rebuild / steps << " ms" << std::endl
+      << "Rebuild/refit      = " << time_rebuild / time_refit << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TIMING 02: Completed" << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return 0;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_timing_02.cc
+///
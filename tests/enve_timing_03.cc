@@ -0,0 +1,160 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_timing_03.cc
+///
+
+#include "enve.hh"
+#include "TicToc.hh"
+
+#include <random>
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(void)
+{
+  // Try block
+  try
+  {
+
+    // Print test main information
+    std::cout
+      << "---------------------------" << std::endl
+      << "TIMING 03 - ENVE MORTON TRIANGLES REORDERING" << std::endl
+      << std::endl;
+
+    // Instantiate a TicToc object
+    TicToc tictoc;
+
+    // Generate a large rough road and allocate its triangles in exporter-like
+    // random order, so that spatially close triangles are scattered in memory
+    ground::generator::parameters data;
+    data.length    = 30.0;
+    data.width     = 30.0;
+    data.roughness = 'B';
+    triangleground::vecptr triangles(ground::generator(data).triangles());
+    std::mt19937 generator(42);
+    std::shuffle(triangles.begin(), triangles.end(), generator);
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+      std::shared_ptr<triangleground> scattered(std::make_shared<triangleground>());
+      scattered->copy(*triangles[i]);
+      triangles[i] = scattered;
+    }
+    ground::mesh shuffled(triangles);
+    ground::mesh sorted(triangles);
+    triangles.clear();
+    tictoc.tic();
+    sorted.reorder();
+    tictoc.toc();
+    real time_reorder = tictoc.elapsed_ms();
+
+    // Candidates memory span per query in triangles (memory locality proxy)
+    ground::mesh const * meshes[2] = {&shuffled, &sorted};
+    real span[2] = {0.0, 0.0}, time_setup[2] = {0.0, 0.0};
+    size_t queries = 2000;
+    triangleground::vecidx indices;
+    for (size_t m = 0; m < 2; ++m)
+    {
+      for (size_t k = 0; k < queries; ++k)
+      {
+        real x = 1.0 + (data.length - 2.0) * k / queries, y = 1.0 + (data.width - 2.0) * ((k * 37) % queries) / queries;
+        meshes[m]->intersection(aabb(x - 0.35, y - 0.2, -1.0, x + 0.35, y + 0.2, 1.0), indices);
+        char const * lower = nullptr;
+        char const * upper = nullptr;
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+          char const * address = reinterpret_cast<char const *>(meshes[m]->ptrTriangleground(indices[i]).get());
+          lower = (lower == nullptr || address < lower) ? address : lower;
+          upper = (upper == nullptr || address > upper) ? address : upper;
+        }
+        span[m] += real(upper - lower) / sizeof(triangleground) / queries;
+      }
+    }
+
+    // Roll the shells on both meshes
+    shell shell_shuffled(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    shell shell_sorted(10, 0.327, 4.0, 0.195, 4.0, 0.188);
+    size_t steps = 5000;
+    for (size_t k = 0; k < steps; ++k)
+    {
+      affine pose(translate(1.0 + (data.length - 2.0) * k / steps, 1.0 + (data.width - 2.0) * ((k * 37) % steps) / steps, 0.3) *
+                  angleaxis(0.1, UNITZ_VEC3));
+      tictoc.tic();
+      shell_shuffled.setup(shuffled, pose, "geometric");
+      tictoc.toc();
+      time_setup[0] += tictoc.elapsed_ms();
+      tictoc.tic();
+      shell_sorted.setup(sorted, pose, "geometric");
+      tictoc.toc();
+      time_setup[1] += tictoc.elapsed_ms();
+    }
+
+    // Output performance data
+    std::cout
+      << "ENVE PERFORMANCE REPORT" << std::endl
+      << "Triangles             = " << sorted.size() << std::endl
+      << "Reordering time       = " << time_reorder << " ms" << std::endl
+      << "Avg. span (shuffled)  = " << span[0] << std::endl
+      << "Avg. span (Morton)    = " << span[1] << std::endl
+      << "Avg. setup (shuffled) = " << 1000.0 * time_setup[0] / steps << " us" << std::endl
+      << "Avg. setup (Morton)   = " << 1000.0 * time_setup[1] / steps << " us" << std::endl;
+
+    // End of test
+    std::cout
+      << std::endl
+      << "TIMING 03: Completed" << std::endl
+      << "---------------------------" << std::endl;
+
+    // Exit the program
+    return 0;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr
+      << std::endl
+      << "Aborted test: unknown error" << std::endl
+      << "---------------------------" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_timing_03.cc
+///
@@ -0,0 +1,97 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_decimate.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Main function
+int
+main(
+  int          argc,
+  char const * argv[]
+)
+{
+  // Try block
+  try
+  {
+    if (argc < 4)
+    {
+      std::cerr
+        << "Usage: enve_decimate <input.rdf|input.obj> <output.rdf> <tolerance> [friction]" << std::endl
+        << "  tolerance : maximum vertical deviation from the input vertices (m)" << std::endl
+        << "  friction  : friction scaling coefficient for *.obj inputs (default 1.0)" << std::endl;
+      return 1;
+    }
+    std::string input(argv[1]), output(argv[2]);
+    real tolerance = real(std::stod(argv[3]));
+    real friction  = argc > 4 ? real(std::stod(argv[4])) : real(1.0);
+
+    // Load the input mesh
+    ground::mesh road;
+    if (input.size() >= 4 && input.substr(input.size() - 4, 4) == ".obj")
+      {road.load(input, friction);}
+    else
+      {road.load(input);}
+
+    // Decimate and write the simplified mesh
+    ground::decimator simplified(road);
+    simplified.simplify(tolerance);
+    if (!simplified.write(output))
+    {
+      std::cerr << "Cannot write " << output << std::endl;
+      return 1;
+    }
+    std::cout
+      << "Input triangles  = " << road.size() << std::endl
+      << "Output triangles = " << simplified.size() << std::endl
+      << "Tolerance        = " << tolerance << " m" << std::endl;
+    return 0;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr << "Aborted: unknown error" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_decimate.cc
+///
@@ -0,0 +1,328 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_explore.cc
+///
+
+#include "enve.hh"
+
+#include <iomanip>
+
+using namespace acme;
+using namespace enve;
+
+// Contact scenario (ground and shell poses)
+struct scenario
+{
+  std::string         name;   // Scenario name
+  ground::mesh::ptr   ground; // Ground mesh
+  std::vector<affine> poses;  // Shell poses
+};
+
+// Contact results of a configuration on a scenario step
+struct sample
+{
+  acme::point position; // Aggregated contact point
+  vec3        normal;   // Aggregated contact normal
+  real        depth;    // Aggregated contact depth
+};
+
+// Configuration errors and cost
+struct result
+{
+  std::string method;  // Enveloping method
+  size_t      ribs;    // Ribs number
+  real        point;   // Worst scenario RMS contact point error (m)
+  real        normal;  // Worst scenario RMS contact normal error (deg)
+  real        depth;   // Worst scenario RMS contact depth error (m)
+  real        cost;    // Mean setup and output time per step (us)
+  bool        pareto;  // Non-dominated in (cost, point error)
+};
+
+// Split a comma separated list
+std::vector<std::string>
+split(
+  std::string const & value
+)
+{
+  std::vector<std::string> items;
+  std::stringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ','))
+    {items.push_back(item);}
+  return items;
+}
+
+// Generated road scenario driven along the x-axis at a lateral position (slightly
+// off the grid lines to keep the ribs planes away from degenerate intersections)
+scenario
+generated(
+  std::string                           const & name,
+  ground::generator::parameters         const & data,
+  real                                          y,
+  size_t                                        steps
+)
+{
+  ground::generator road(data);
+  scenario s{name, road.build(), {}};
+  y += 0.137 * data.spacing;
+  for (size_t k = 0; k < steps; ++k)
+  {
+    real x = 1.0 + (data.length - 2.0) * k / steps;
+    s.poses.push_back(translate(x, y, road.height(x, y) + 0.327 - 0.02) * angleaxis(0.03, UNITX_VEC3));
+  }
+  return s;
+}
+
+// Contact results of a shell along a scenario (cost in us per step)
+real
+run(
+  shell                     & tire,
+  scenario            const & s,
+  std::string         const & method,
+  std::vector<sample>       & samples
+)
+{
+  samples.resize(s.poses.size());
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (size_t k = 0; k < s.poses.size(); ++k)
+  {
+    tire.setup(*s.ground, s.poses[k], method);
+    tire.contactPoint(samples[k].position);
+    tire.contactNormal(samples[k].normal);
+    tire.contactDepth(samples[k].depth);
+  }
+  return std::chrono::duration<real, std::micro>(std::chrono::steady_clock::now() - start).count() / s.poses.size();
+}
+
+// Main function
+int
+main(
+  int          argc,
+  char const * argv[]
+)
+{
+  // Try block
+  try
+  {
+    // Parse the explorer options (key=value, lists comma separated)
+    std::string prefix("./enve_explore");
+    std::vector<std::string> ribs = {"1", "2", "3", "5", "10", "20", "50", "100"}, methods = {"geometric", "sampling"};
+    std::vector<std::string> meshes;
+    size_t reference = 500, steps = 100;
+    real   tol_point = 1.0e-3, tol_normal = 1.0, tol_depth = 1.0e-3;
+    for (int k = 1; k < argc; ++k)
+    {
+      std::string argument(argv[k]);
+      size_t equal = argument.find('=');
+      if (equal == std::string::npos) {prefix = argument; continue;}
+      std::string key(argument.substr(0, equal)), value(argument.substr(equal + 1));
+      if      (key == "ribs")       {ribs       = split(value);}
+      else if (key == "method")     {methods    = split(value);}
+      else if (key == "mesh")       {meshes     = split(value);}
+      else if (key == "reference")  {reference  = size_t(std::stoul(value));}
+      else if (key == "steps")      {steps      = size_t(std::stoul(value));}
+      else if (key == "tol_point")  {tol_point  = std::stod(value);}
+      else if (key == "tol_normal") {tol_normal = std::stod(value);}
+      else if (key == "tol_depth")  {tol_depth  = std::stod(value);}
+      else
+      {
+        std::cerr
+          << "Usage: enve_explore [prefix] [key=value ...]" << std::endl
+          << "  ribs=1,2,3,5,10,20,50,100  rib counts to sweep" << std::endl
+          << "  method=geometric,sampling  methods to sweep" << std::endl
+          << "  mesh=a.rdf,b.obj           extra scenarios (driven along x through the mesh centre)" << std::endl
+          << "  reference=500              reference rib count (geometric)" << std::endl
+          << "  steps=100                  steps per scenario" << std::endl
+          << "  tol_point=1e-3             contact point tolerance (m)" << std::endl
+          << "  tol_normal=1               contact normal tolerance (deg)" << std::endl
+          << "  tol_depth=1e-3             contact depth tolerance (m)" << std::endl;
+        return 1;
+      }
+    }
+
+    // Scenario set: smooth and rough roads, kerb edge, potholes and cobblestones
+    std::vector<scenario> scenarios;
+    ground::generator::parameters data;
+    data.length  = 12.0;
+    data.width   = 2.0;
+    data.spacing = 0.02;
+    data.seed    = 7;
+    data.roughness = 'A';
+    scenarios.push_back(generated("smooth", data, 1.0, steps));
+    data.roughness = 'E';
+    scenarios.push_back(generated("rough", data, 1.0, steps));
+    data.roughness   = 'B';
+    data.kerb_height = 0.08;
+    scenarios.push_back(generated("kerb", data, 0.3, steps));
+    data.kerb_height = 0.0;
+    data.width       = 0.8;
+    data.potholes    = 8;
+    scenarios.push_back(generated("potholes", data, 0.4, steps));
+    data.width             = 2.0;
+    data.potholes          = 0;
+    data.cobblestone_start = 0.0;
+    data.cobblestone_end   = data.length;
+    data.cobblestone_size  = 0.12;
+    data.cobblestone_height = 0.015;
+    scenarios.push_back(generated("cobblestones", data, 1.0, steps));
+    for (size_t m = 0; m < meshes.size(); ++m)
+    {
+      std::string const & path = meshes[m];
+      ground::mesh::ptr road(path.size() >= 4 && path.substr(path.size() - 4, 4) == ".obj" ?
+        std::make_shared<ground::mesh const>(path, 1.0) : std::make_shared<ground::mesh const>(path));
+      aabb box(road->bbox());
+      scenario s{path, road, {}};
+      real y = 0.5 * (box.min().y() + box.max().y());
+      for (size_t k = 0; k < steps; ++k)
+      {
+        real x = box.min().x() + 1.0 + (box.max().x() - box.min().x() - 2.0) * k / steps;
+        s.poses.push_back(affine(translate(x, y, box.max().z() + 0.307)));
+      }
+      scenarios.push_back(s);
+    }
+
+    // High resolution reference
+    std::cout << "Computing the reference (" << reference << " ribs, geometric)..." << std::endl;
+    std::vector<std::vector<sample>> references(scenarios.size());
+    shell reference_shell(reference, 0.327, 4.0, 0.195, 4.0, 0.188);
+    for (size_t s = 0; s < scenarios.size(); ++s)
+      {run(reference_shell, scenarios[s], "geometric", references[s]);}
+
+    // Sweep the configurations
+    std::vector<result> results;
+    std::vector<sample> samples;
+    for (size_t m = 0; m < methods.size(); ++m)
+    {
+      for (size_t r = 0; r < ribs.size(); ++r)
+      {
+        result res{methods[m], size_t(std::stoul(ribs[r])), 0.0, 0.0, 0.0, 0.0, false};
+        shell tire(res.ribs, 0.327, 4.0, 0.195, 4.0, 0.188);
+        for (size_t s = 0; s < scenarios.size(); ++s)
+        {
+          try
+          {
+            run(tire, scenarios[s], res.method, samples);
+            res.cost += run(tire, scenarios[s], res.method, samples) / scenarios.size();
+          }
+          catch (std::exception const & exc)
+          {
+            // Degenerate intersections make the configuration unusable
+            std::cerr << res.method << " with " << res.ribs << " ribs failed on " << scenarios[s].name << ": " << exc.what() << std::endl;
+            res.point = res.normal = res.depth = INFTY;
+            break;
+          }
+          real e_point = 0.0, e_normal = 0.0, e_depth = 0.0;
+          for (size_t k = 0; k < samples.size(); ++k)
+          {
+            sample const & ref = references[s][k];
+            real cosine = std::max(-1.0, std::min(1.0, samples[k].normal.dot(ref.normal)));
+            e_point  += (samples[k].position - ref.position).squaredNorm();
+            e_normal += std::pow(std::acos(cosine) * 180.0 / PI, 2);
+            e_depth  += std::pow(samples[k].depth - ref.depth, 2);
+          }
+          res.point  = std::max(res.point,  std::sqrt(e_point  / samples.size()));
+          res.normal = std::max(res.normal, std::sqrt(e_normal / samples.size()));
+          res.depth  = std::max(res.depth,  std::sqrt(e_depth  / samples.size()));
+        }
+        results.push_back(res);
+      }
+    }
+
+    // Pareto front on cost and contact point error
+    std::vector<size_t> order(results.size());
+    for (size_t i = 0; i < order.size(); ++i) {order[i] = i;}
+    std::sort(order.begin(), order.end(), [&results](size_t a, size_t b) {return results[a].cost < results[b].cost;});
+    real best = INFTY;
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+      result & res = results[order[i]];
+      if (res.point < best) {res.pareto = true; best = res.point;}
+    }
+
+    // Cheapest configuration meeting the tolerances
+    result const * choice = nullptr;
+    for (size_t i = 0; i < order.size() && choice == nullptr; ++i)
+    {
+      result const & res = results[order[i]];
+      if (res.point <= tol_point && res.normal <= tol_normal && res.depth <= tol_depth) {choice = &res;}
+    }
+
+    // Report
+    std::ofstream file(prefix + ".csv");
+    file << "method,ribs,point_error_m,normal_error_deg,depth_error_m,cost_us,pareto,meets_tolerance" << std::endl;
+    std::cout
+      << std::endl
+      << std::setw(10) << "method" << std::setw(6) << "ribs" << std::setw(13) << "point [m]" << std::setw(13) << "normal [deg]"
+      << std::setw(13) << "depth [m]" << std::setw(11) << "cost [us]" << "  pareto" << std::endl;
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+      result const & res = results[order[i]];
+      bool meets = res.point <= tol_point && res.normal <= tol_normal && res.depth <= tol_depth;
+      file
+        << res.method << "," << res.ribs << "," << res.point << "," << res.normal << "," << res.depth << ","
+        << res.cost << "," << res.pareto << "," << meets << std::endl;
+      std::cout
+        << std::setw(10) << res.method << std::setw(6) << res.ribs << std::scientific << std::setprecision(3)
+        << std::setw(13) << res.point << std::setw(13) << res.normal << std::setw(13) << res.depth
+        << std::fixed << std::setprecision(1) << std::setw(11) << res.cost << (res.pareto ? "  *" : "") << std::endl;
+      std::cout.unsetf(std::ios::floatfield);
+      std::cout << std::setprecision(6);
+    }
+    std::cout << std::endl;
+    if (choice != nullptr)
+    {
+      std::cout
+        << "Cheapest configuration within tolerances: " << choice->method << " with " << choice->ribs << " ribs ("
+        << choice->cost << " us per step)" << std::endl;
+    }
+    else
+    {
+      std::cout << "No configuration meets the tolerances" << std::endl;
+    }
+    std::cout << "Results written to " << prefix << ".csv" << std::endl;
+    return choice != nullptr ? 0 : 2;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr << "Aborted: unknown error" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_explore.cc
+///
@@ -0,0 +1,149 @@
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                     *
+ * The ENVE project                                                    *
+ *                                                                     *
+ * Copyright (c) 2020, Davide Stocco and Enrico Bertolazzi.            *
+ *                                                                     *
+ * The ENVE project and its components are supplied under the terms of *
+ * the open source BSD 3-Clause License. The contents of the ENVE      *
+ * project and its components may not be copied or disclosed except in *
+ * accordance with the terms of the BSD 3-Clause License.              *
+ *                                                                     *
+ * URL: https://opensource.org/licenses/BSD-3-Clause                   *
+ *                                                                     *
+ *    Davide Stocco                                                    *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: davide.stocco@unitn.it                                   *
+ *                                                                     *
+ *    Enrico Bertolazzi                                                *
+ *    Department of Industrial Engineering                             *
+ *    University of Trento                                             *
+ *    e-mail: enrico.bertolazzi@unitn.it                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+///
+/// file: enve_generate.cc
+///
+
+#include "enve.hh"
+
+using namespace acme;
+using namespace enve;
+
+// Split a colon separated list of numbers
+std::vector<real>
+split(
+  std::string const & value
+)
+{
+  std::vector<real> numbers;
+  std::stringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ':'))
+    {numbers.push_back(real(std::stod(item)));}
+  return numbers;
+}
+
+// Main function
+int
+main(
+  int          argc,
+  char const * argv[]
+)
+{
+  // Try block
+  try
+  {
+    if (argc < 2)
+    {
+      std::cerr
+        << "Usage: enve_generate <output.rdf|output.obj> [key=value ...]" << std::endl
+        << "  length=100      road length (m)" << std::endl
+        << "  width=4         road width (m)" << std::endl
+        << "  spacing=0.05    grid spacing (m)" << std::endl
+        << "  class=A         ISO 8608 roughness class A-H (none for a smooth road)" << std::endl
+        << "  kerb=h[:w]      kerbs height and width (m)" << std::endl
+        << "  potholes=n[:r:d] number, maximum radius and depth (m) of the potholes" << std::endl
+        << "  cobble=x0:x1[:s:h] cobblestone section, stones size and height (m)" << std::endl
+        << "  banking=0       banking angle (rad)" << std::endl
+        << "  friction=1      base friction scaling coefficient" << std::endl
+        << "  patch=x0:x1:y0:y1:mu friction patch (repeatable)" << std::endl
+        << "  seed=0          random generator seed" << std::endl;
+      return 1;
+    }
+    std::string output(argv[1]);
+
+    // Parse the road parameters
+    ground::generator::parameters data;
+    for (int k = 2; k < argc; ++k)
+    {
+      std::string argument(argv[k]);
+      size_t equal = argument.find('=');
+      if (equal == std::string::npos)
+        {ENVE_ERROR("enve_generate: expected key=value, got '" + argument + "'.");}
+      std::string key(argument.substr(0, equal)), value(argument.substr(equal + 1));
+      std::vector<real> numbers(key == "class" ? std::vector<real>() : split(value));
+      if      (key == "length")   {data.length  = numbers.at(0);}
+      else if (key == "width")    {data.width   = numbers.at(0);}
+      else if (key == "spacing")  {data.spacing = numbers.at(0);}
+      else if (key == "class")    {data.roughness = value == "none" ? 0 : char(std::toupper(value.at(0)));}
+      else if (key == "banking")  {data.banking  = numbers.at(0);}
+      else if (key == "friction") {data.friction = numbers.at(0);}
+      else if (key == "seed")     {data.seed = std::uint32_t(numbers.at(0));}
+      else if (key == "kerb")
+      {
+        data.kerb_height = numbers.at(0);
+        if (numbers.size() > 1) {data.kerb_width = numbers[1];}
+      }
+      else if (key == "potholes")
+      {
+        data.potholes = size_t(numbers.at(0));
+        if (numbers.size() > 2) {data.pothole_radius = numbers[1]; data.pothole_depth = numbers[2];}
+      }
+      else if (key == "cobble")
+      {
+        data.cobblestone_start = numbers.at(0);
+        data.cobblestone_end   = numbers.at(1);
+        if (numbers.size() > 3) {data.cobblestone_size = numbers[2]; data.cobblestone_height = numbers[3];}
+      }
+      else if (key == "patch")
+        {data.patches.push_back({numbers.at(0), numbers.at(1), numbers.at(2), numbers.at(3), numbers.at(4)});}
+      else
+        {ENVE_ERROR("enve_generate: unknown key '" + key + "'.");}
+    }
+
+    // Stream the road to file
+    ground::generator road(data);
+    if (!road.write(output))
+    {
+      std::cerr << "Cannot write " << output << std::endl;
+      return 1;
+    }
+    std::cout
+      << "Output triangles = " << road.size() << std::endl
+      << "Roughness class  = " << (data.roughness == 0 ? '-' : data.roughness) << std::endl
+      << "Seed             = " << data.seed << std::endl;
+    return 0;
+  }
+
+  // Exception catch block
+  catch (std::exception const &exc)
+  {
+    std::cerr << exc.what() << std::endl;
+  }
+
+  // Default catch block
+  catch (...)
+  {
+    std::cerr << "Aborted: unknown error" << std::endl;
+  }
+  return 1;
+}
+
+///
+/// eof: enve_generate.cc
+///